@@ -0,0 +1,170 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CHILD_VECTOR_H
+#define CHILD_VECTOR_H
+
+#include <memory_resource>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+// number of children stored inside a tree node before the child vector spills over to memory from the pool
+#define TREE_CHILD_INLINE_CAPACITY      4
+
+namespace Collections {
+namespace Memory {
+    /* a vector with the first N elements stored inline (inside the object itself), used for the child pointers of a tree
+     * node. A node with N or fewer children needs no allocation for its child vector at all, and its child pointers sit
+     * right next to the rest of the node. Once the vector grows past N, the elements are moved to memory allocated from
+     * the memory resource passed in (the tree's node pool)
+     *
+     * Note that only the operations needed by the tree are provided, and since the elements are pointers (trivially
+     * copyable) we move them around with memmove
+    */
+    template <typename T, size_t N>
+    class ChildVector {
+        static_assert (std::is_trivially_copyable <T>::value, "child vector elements should be trivially copyable");
+
+        private:
+            T* m_data;
+            uint32_t m_size;
+            uint32_t m_capacity;
+            std::pmr::memory_resource* m_resource;
+            T m_inline[N > 0 ? N : 1];
+
+            inline bool isInline (void) const {
+                return m_data == m_inline;
+            }
+
+            // capacity doubles every time we run out of space
+            void grow (size_t minCapacity) {
+                size_t newCapacity = std::max (static_cast <size_t> (m_capacity) * 2, minCapacity);
+                T* newData = static_cast <T*> (m_resource-> allocate (newCapacity * sizeof (T), alignof (T)));
+
+                std::memcpy (newData, m_data, m_size * sizeof (T));
+                if (!isInline())
+                    m_resource-> deallocate (m_data, m_capacity * sizeof (T), alignof (T));
+
+                m_data = newData;
+                m_capacity = static_cast <uint32_t> (newCapacity);
+            }
+
+        public:
+            typedef T* iterator;
+            typedef const T* const_iterator;
+
+            ChildVector (std::pmr::memory_resource* resource) {
+                m_data     = m_inline;
+                m_size     = 0;
+                m_capacity = N > 0 ? N : 1;
+                m_resource = resource;
+            }
+
+            ChildVector (const ChildVector& other, std::pmr::memory_resource* resource) : ChildVector (resource) {
+                *this = other;
+            }
+
+            // the inline elements can't be shared, so a copy always needs to be told which memory resource to use
+            ChildVector (const ChildVector& other) = delete;
+
+            ~ChildVector (void) {
+                if (!isInline())
+                    m_resource-> deallocate (m_data, m_capacity * sizeof (T), alignof (T));
+            }
+
+            // copy elements only, the memory resource of this vector is retained
+            ChildVector& operator = (const ChildVector& other) {
+                if (this == &other)
+                    return *this;
+
+                if (other.m_size > m_capacity)
+                    grow (other.m_size);
+
+                std::memcpy (m_data, other.m_data, other.m_size * sizeof (T));
+                m_size = other.m_size;
+                return *this;
+            }
+
+            inline std::pmr::memory_resource* getResource (void) const {
+                return m_resource;
+            }
+
+            inline size_t size (void) const {
+                return m_size;
+            }
+
+            inline bool empty (void) const {
+                return m_size == 0;
+            }
+
+            inline T& operator [] (size_t idx) {
+                return m_data[idx];
+            }
+
+            inline T& back (void) {
+                return m_data[m_size - 1];
+            }
+
+            inline iterator begin (void)                { return m_data; }
+            inline iterator end (void)                  { return m_data + m_size; }
+            inline const_iterator begin (void) const    { return m_data; }
+            inline const_iterator end (void) const      { return m_data + m_size; }
+
+            void push_back (T value) {
+                if (m_size == m_capacity)
+                    grow (m_size + 1);
+
+                m_data[m_size++] = value;
+            }
+
+            inline void pop_back (void) {
+                m_size--;
+            }
+
+            iterator insert (const_iterator position, T value) {
+                return insert (position, &value, &value + 1);
+            }
+
+            // the range to be inserted is expected to be outside this vector
+            iterator insert (const_iterator position, const_iterator first, const_iterator last) {
+                size_t offset = position - m_data;
+                size_t count  = last - first;
+
+                if (m_size + count > m_capacity)
+                    grow (m_size + count);
+
+                std::memmove (m_data + offset + count, m_data + offset, (m_size - offset) * sizeof (T));
+                std::memcpy  (m_data + offset, first, count * sizeof (T));
+                m_size += static_cast <uint32_t> (count);
+                return m_data + offset;
+            }
+
+            iterator erase (const_iterator first, const_iterator last) {
+                size_t offset = first - m_data;
+                size_t count  = last - first;
+
+                std::memmove (m_data + offset, m_data + offset + count, (m_size - offset - count) * sizeof (T));
+                m_size -= static_cast <uint32_t> (count);
+                return m_data + offset;
+            }
+
+            // memory that has already spilled over is kept for reuse
+            inline void clear (void) {
+                m_size = 0;
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // CHILD_VECTOR_H
@@ -59,12 +59,46 @@
 #define TREE_SWAP(idA, idB)                     swap (idA, idB)
 #define TREE_IMPORT(node)                       importTree (node)
 #define TREE_RESET                              importTree (NULL)
+/* build the nodes of a tree in one pass from (id, parent id, data) tuples or a parent index array (see buildTree()), the 
+ * returned root node is then imported using TREE_IMPORT. The built nodes come from this tree's pool and, same as an
+ * adopted tree, are only freed once imported (or appended) into a tree; a built tree that is dropped is never freed
+*/
+#define TREE_BUILD(input)                       buildTree (input)
+#define TREE_BUILD_FROM_PARENTS(parents, data)  buildTree (parents, data)
+/* batch updates, descendant counts are recomputed once when the batch is committed instead of on every add/remove, use
+ * this for bulk tree builds
+*/
+#define TREE_BATCH_BEGIN                        beginBatch()
+#define TREE_BATCH_COMMIT                       commitBatch()
 
 // 'utils' methods
 #define TREE_SIZE                               getSize()
 #define TREE_DEPTH                              getDepth()
 #define TREE_PATH(idA, idB)                     getPath (idA, idB)
+// lowest common ancestor node (NULL if either id is invalid), and ancestor check (a node is an ancestor of itself)
+#define TREE_LCA(idA, idB)                      getLCA (idA, idB)
+#define TREE_IS_ANCESTOR(idA, idB)              isAncestor (idA, idB)
 #define TREE_TAILS                              getTails()
+/* immutable, flattened (preorder) copy of the tree for read heavy use, for example
+ *      auto myFrozen = myTree-> TREE_FREEZE;
+ *      uint32_t position = myFrozen.find (id);
+ *      for (auto const& data : myFrozen.getSubtree (position))
+ *          ...
+ *
+ * nodes are addressed by their position in the frozen tree (TREE_FROZEN_NONE if there is no such node), the following
+ * operations are available on a frozen tree: getSize(), find (id), getId (position), getData (position), getLevel 
+ * (position), getParent (position), getFirstChild (position), getNextSibling (position), getSubtreeEnd (position), 
+ * getSubtree (position), isAncestor (positionA, positionB) and getCursor(). A cursor walks the frozen tree using 
+ * peekSet (id), peekSetRoot(), peekSetParent(), peekSetChild(), peekSetNextSibling(), peekSetNext() (preorder), 
+ * peekIsEnd() and peekPosition()
+*/
+#define TREE_FREEZE                             freeze()
+/* bottom up fold and unordered visit over all nodes, split across numThreads threads at subtree boundaries. The fold 
+ * lambda (T*, std::span <const resultType>) returns the result of a node given its data and the results of its children
+*/
+#define TREE_FOLD_PARALLEL(resultType,                                                                          \
+                           numThreads, lambda)  foldParallel <resultType> (numThreads, lambda)
+#define TREE_VISIT_PARALLEL(numThreads, lambda) visitParallel (numThreads, lambda)
 #define TREE_DUMP                               dump (std::cout)
 #define TREE_DUMP_CUSTOM(lambda)                dump (std::cout, lambda)                                  
 #endif  // TREE_H
\ No newline at end of file
@@ -15,19 +15,41 @@
 #define TREE_IMPL_H
 
 #include "../../../Admin/InstanceMgr.h"
+#include "ChildVector.h"
 #include <queue>
+#include <unordered_map>
+#include <span>
+#include <thread>
+#include <atomic>
+#include <bit>
+#include <tuple>
+
+/* parallel fold and visit split the tree into subtree tasks of roughly (size / (numThreads * PARALLEL_FOLD_TASKS_PER_THREAD))
+ * nodes each, but never smaller than PARALLEL_FOLD_MIN_NODES; smaller trees are done on the calling thread
+*/
+#define PARALLEL_FOLD_MIN_NODES         4096
+#define PARALLEL_FOLD_TASKS_PER_THREAD  8
+// position used in a frozen tree for a parent, child or sibling that doesn't exist
+#define TREE_FROZEN_NONE                UINT32_MAX
+// parent id (or parent index) of the root node in the input to buildTree()
+#define TREE_BUILD_NO_PARENT            SIZE_MAX
 
 namespace Collections {
 namespace Memory {
-    template <typename T>
+    // N is the number of children a node can hold inline, before its child vector needs memory from the node pool
+    template <typename T, size_t N = TREE_CHILD_INLINE_CAPACITY>
     class Tree: public Admin::NonTemplateBase {
         protected:
             // node definition
             typedef struct Node {
                 size_t id;
                 size_t numDescendants;
+                // stored relative to the tree's level base, use getLevel() for the level of the node in the tree
+                size_t level;
+                // number of levels below the node, 0 if the node has no (non NULL) children
+                size_t height;
                 Node* parent;
-                std::vector <Node*> child;
+                ChildVector <Node*, N> child;
                 T data;
             }s_Node;
             
@@ -86,6 +108,59 @@ namespace Memory {
                 m_stickyPeek = { NULL, 0 };
             }
 
+            /* add a new node in place of a NULL child of the peek node. Unlike addChild(), the new node takes the position 
+             * of the NULL child in the child vector instead of being added at the end
+            */
+            bool addChildAt (size_t position, size_t id, const T& data) {
+                s_Node* parentNode = peekNode();
+                // peek node id not found, or no NULL child at position
+                if (parentNode == NULL || position >= parentNode-> child.size() || parentNode-> child[position] != NULL)
+                    return false;
+
+                s_Node* newNode = createNode (id, data);
+                // update number of descendants of all parents up to the root node
+                updateDescendants (parentNode, 1, true);
+
+                parentNode-> child[position] = newNode;
+                newNode-> parent = parentNode;
+                newNode-> level = parentNode-> level + 1;
+
+                // the new node replaces the NULL child in the level count
+                countLevel (getLevel (newNode), false);
+                indexNode (newNode);
+                updateHeight (parentNode);
+                return true;
+            }
+
+            /* the deepest node in the tree (the right most one, if there are more than one), which is also the last tail in
+             * level order. We go down from the root node through the right most child that holds the height of its parent,
+             * which is O(depth) on the first call after the tree was updated and O(1) after that
+            */
+            s_Node* getDeepestNode (void) {
+                if (m_rootNode == NULL)
+                    return NULL;
+
+                if (m_deepestNode != NULL)
+                    return m_deepestNode;
+
+                // heights are stale in a batch update
+                syncDescendants();
+
+                s_Node* currentNode = m_rootNode;
+                while (currentNode-> height != 0) {
+                    for (auto iter = currentNode-> child.end(); iter != currentNode-> child.begin();) {
+                        --iter;
+                        if (*iter != NULL && (*iter)-> height + 1 == currentNode-> height) {
+                            currentNode = *iter;
+                            break;
+                        }
+                    }
+                }
+
+                m_deepestNode = currentNode;
+                return m_deepestNode;
+            }
+
         private:
             size_t m_instanceId;
             std::pair <s_Node*, size_t> m_stickyPeek;
@@ -94,30 +169,231 @@ namespace Memory {
             std::pair <s_Node*, size_t> m_savePeek;
 
             // these two members are necessary to perform efficient tree traversal
-            std::queue <s_Node*> m_stepperQueue;
+            std::deque <s_Node*> m_stepperQueue;
             size_t m_nodesInLevel;
 
+            /* peekSet() jumps straight to the node using the index below, which leaves the stepper queue behind. This
+             * flag marks the queue as stale so that the next peekSetNext() can rebuild it from the peek node. We also
+             * save the child count of the peek node, so that the rebuilt queue doesn't see children added after peek
+             * was set (same as a queue that was built when peek was set)
+            */
+            bool m_stepperStale;
+            size_t m_staleChildCount;
+
+            // id to node index, every node linked to the root has an entry here
+            std::unordered_map <size_t, s_Node*> m_nodeIndex;
+
+            /* number of entries in each level of the tree, [level - 1] -> count. Note that NULL children are also counted
+             * here since they occupy a level in the level order traversal. The vector is trimmed so that its size is always
+             * the depth of the tree
+            */
+            std::vector <size_t> m_levelCount;
+            /* the level of a node is (node-> level - m_levelBase). Adding a new root moves every node down a level, which
+             * is done by moving the base instead of walking the tree. The subtraction is allowed to wrap around, only the
+             * difference is ever used
+            */
+            size_t m_levelBase;
+
+            /* in a batch update, the descendant counts (and heights) are not updated up to the root on every add/remove.
+             * Instead, they are marked stale and recomputed in a single bottom up pass when the batch is committed (or when
+             * the counts are needed before that)
+            */
+            bool m_batchUpdate;
+            bool m_descendantsStale;
+
+            /* lowest common ancestor index, built on the first query after the tree was updated. Nodes are numbered in
+             * preorder, so B is in the subtree of A if A <= B < subtreeEnd[A]. For two nodes A < B where neither is an 
+             * ancestor of the other, the node with the lowest level in preorder range (A, B] is a child of their LCA, 
+             * which we look up in O(1) using a sparse table (table[k][i] -> position with the lowest level in the range 
+             * [i, i + 2^k))
+            */
+            typedef struct LcaIndex {
+                bool isValid;
+                std::unordered_map <size_t, uint32_t> positions;
+                std::vector <s_Node*> nodes;
+                std::vector <uint32_t> subtreeEnds;
+                std::vector <std::vector <uint32_t>> table;
+            }s_LcaIndex;
+
+            s_LcaIndex m_lcaIndex;
+
+            /* results of getTails() and getDeepestNode() are kept till the tree is updated, so that repeated queries on an
+             * unchanged tree are O(#tails) and O(1)
+            */
+            std::vector <size_t> m_tails;
+            bool m_tailsStale;
+            s_Node* m_deepestNode;
+
+            inline void invalidateQueryCache (void) {
+                m_lcaIndex.isValid = false;
+                m_tailsStale = true;
+                m_deepestNode = NULL;
+            }
+
+            void buildLcaIndex (void) {
+                m_lcaIndex.positions.clear();
+                m_lcaIndex.nodes.clear();
+                m_lcaIndex.table.clear();
+
+                if (m_rootNode != NULL) {
+                    // preorder
+                    std::vector <s_Node*> pendingStack;
+                    pendingStack.push_back (m_rootNode);
+
+                    while (!pendingStack.empty()) {
+                        s_Node* currentNode = pendingStack.back();
+                        pendingStack.pop_back();
+
+                        m_lcaIndex.positions[currentNode-> id] = static_cast <uint32_t> (m_lcaIndex.nodes.size());
+                        m_lcaIndex.nodes.push_back (currentNode);
+
+                        for (auto iter = currentNode-> child.end(); iter != currentNode-> child.begin();) {
+                            --iter;
+                            if (*iter != NULL)
+                                pendingStack.push_back (*iter);
+                        }
+                    }
+                }
+
+                uint32_t numNodes = static_cast <uint32_t> (m_lcaIndex.nodes.size());
+                // subtree ends, from the last node in preorder back to the root
+                m_lcaIndex.subtreeEnds.assign (numNodes, 0);
+                for (uint32_t position = numNodes; position-- > 0;) {
+                    uint32_t subtreeEnd = position + 1;
+                    for (auto const& child : m_lcaIndex.nodes[position]-> child) {
+                        if (child != NULL)
+                            subtreeEnd = std::max (subtreeEnd, m_lcaIndex.subtreeEnds[m_lcaIndex.positions[child-> id]]);
+                    }
+                    m_lcaIndex.subtreeEnds[position] = subtreeEnd;
+                }
+
+                // sparse table
+                if (numNodes > 0) {
+                    m_lcaIndex.table.emplace_back (numNodes);
+                    for (uint32_t position = 0; position < numNodes; position++)
+                        m_lcaIndex.table[0][position] = position;
+                }
+
+                for (size_t k = 1; (static_cast <size_t> (1) << k) <= numNodes; k++) {
+                    size_t half = static_cast <size_t> (1) << (k - 1);
+                    std::vector <uint32_t>& previousRow = m_lcaIndex.table[k - 1];
+                    std::vector <uint32_t> row (numNodes - 2 * half + 1);
+
+                    for (size_t i = 0; i < row.size(); i++)
+                        row[i] = lowerLevel (previousRow[i], previousRow[i + half]);
+                    m_lcaIndex.table.push_back (std::move (row));
+                }
+                m_lcaIndex.isValid = true;
+            }
+
+            inline uint32_t lowerLevel (uint32_t positionA, uint32_t positionB) {
+                return (getLevel (m_lcaIndex.nodes[positionA]) <= getLevel (m_lcaIndex.nodes[positionB])) ? positionA : 
+                                                                                                         positionB;
+            }
+
+            // position with the lowest level in the preorder range [first, last]
+            inline uint32_t lowestInRange (uint32_t first, uint32_t last) {
+                size_t k = std::bit_width (static_cast <size_t> (last - first + 1)) - 1;
+                return lowerLevel (m_lcaIndex.table[k][first], 
+                                   m_lcaIndex.table[k][last + 1 - (static_cast <size_t> (1) << k)]);
+            }
+
+            // returns { position, true } if the id is in the tree, index is built if needed
+            std::pair <uint32_t, bool> getLcaPosition (size_t id) {
+                if (m_lcaIndex.isValid == false)
+                    buildLcaIndex();
+
+                auto iter = m_lcaIndex.positions.find (id);
+                if (iter == m_lcaIndex.positions.end())
+                    return { 0, false };
+                return { iter-> second, true };
+            }
+
+            /* nodes (and child vectors that outgrow their inline storage) are allocated from a pool owned by the tree, so a
+             * tree build is mostly carving out memory from large blocks instead of a malloc per node. Freed nodes go back to the
+             * pool they came from, and when the whole tree is removed the pool gives back all its blocks at once.
+             * 
+             * Adopted nodes/trees may be appended to or imported into another tree, so a pool can outlive the tree that
+             * owns it. The pool keeps count of its live nodes, and is deleted by whichever happens last - the owner tree
+             * is closed, or the last node from the pool is destroyed
+            */
+            class NodePool: public std::pmr::unsynchronized_pool_resource {
+                private:
+                    size_t m_numNodes;
+                    bool m_ownerClosed;
+
+                public:
+                    NodePool (void) {
+                        m_numNodes    = 0;
+                        m_ownerClosed = false;
+                    }
+
+                    inline void addNode (void) {
+                        m_numNodes++;
+                    }
+
+                    inline void removeNode (void) {
+                        m_numNodes--;
+                    }
+
+                    inline size_t getNumNodes (void) const {
+                        return m_numNodes;
+                    }
+
+                    inline void setOwnerClosed (void) {
+                        m_ownerClosed = true;
+                    }
+
+                    inline bool isOwnerClosed (void) const {
+                        return m_ownerClosed;
+                    }
+
+                    // give back all blocks at once, the caller has already destroyed every live node from this pool
+                    inline void releaseNodes (void) {
+                        release();
+                        m_numNodes = 0;
+                    }
+            };
+
+            NodePool* m_nodePool;
+            // number of nodes in the tree that were allocated from the pool of another tree
+            size_t m_numForeignNodes;
+
+            // every child vector is created with the pool of its node
+            static inline NodePool* getPool (s_Node* node) {
+                return static_cast <NodePool*> (node-> child.getResource());
+            }
+
             /* new node created will have
              * [id]             -> note that id validity should be checked by the user
              * numDescendants   -> 0
+             * level            -> 0
              * parent           -> NULL
              * child            -> {  }
              * [data]           -> payload
             */
             s_Node* createNode (size_t id, const T& data) {
-                s_Node* newNode = new s_Node;
+                void* memory = m_nodePool-> allocate (sizeof (s_Node), alignof (s_Node));
+                s_Node* newNode = new (memory) s_Node { id, 0, 0, 0, NULL, ChildVector <s_Node*, N> (m_nodePool), data };
 
-                newNode-> id = id;
-                newNode-> numDescendants = 0;
-                newNode-> parent = NULL;
-                newNode-> data = data;
+                m_nodePool-> addNode();
                 return newNode;
             }
 
+            // destroy a node that has already been unlinked, its memory goes back to the pool it was allocated from
+            static void destroyNode (s_Node* node) {
+                NodePool* nodePool = getPool (node);
+                node-> ~s_Node();
+                nodePool-> deallocate (node, sizeof (s_Node), alignof (s_Node));
+
+                nodePool-> removeNode();
+                if (nodePool-> isOwnerClosed() == true && nodePool-> getNumNodes() == 0)
+                    delete nodePool;
+            }
+
             void stepperReset (void) {
                 // clear queue
-                while (!m_stepperQueue.empty())
-                    m_stepperQueue.pop();
+                m_stepperQueue.clear();
             }
 
             /* queue contents could either be
@@ -128,7 +404,7 @@ namespace Memory {
                 if (m_rootNode == NULL)
                     return;
 
-                m_stepperQueue.push (m_rootNode);
+                m_stepperQueue.push_back (m_rootNode);
                 m_nodesInLevel = m_stepperQueue.size();
             }
             
@@ -149,11 +425,11 @@ namespace Memory {
 
                     // get next node in queue
                     s_Node* currentNode = m_stepperQueue.front();
-                    m_stepperQueue.pop();
+                    m_stepperQueue.pop_front();
 
                     if (currentNode != NULL) {
                         for (auto const& child : currentNode-> child)
-                            m_stepperQueue.push (child);
+                            m_stepperQueue.push_back (child);
                     }
 
                     // not end of tree, current node, don't update level count
@@ -170,10 +446,11 @@ namespace Memory {
              * 
              * note that this method also inherently refreshes the stepper queue
             */
-            std::pair <s_Node*, size_t> getNode (size_t id) {
+            std::pair <s_Node*, size_t> stepperSeek (size_t id) {
                 // always reset queue and start from root
                 stepperReset();
                 stepperStart();
+                m_stepperStale = false;
 
                 /* Here, ret could be either of the following
                  * { false { root, false } }    -> we have root node
@@ -207,6 +484,306 @@ namespace Memory {
                 return { NULL, level };
             }
 
+            /* returns either of the 2 pairs
+             * { node, level }  -> if the id passed in is valid, looked up from the index
+             * { NULL, depth}   -> otherwise, the stepper queue is cleared as if we had traversed to the end of tree
+            */
+            std::pair <s_Node*, size_t> getNode (size_t id) {
+                typename std::unordered_map <size_t, s_Node*>::iterator iter = m_nodeIndex.find (id);
+                if (iter == m_nodeIndex.end()) {
+                    stepperReset();
+                    m_stepperStale = false;
+                    return { NULL, getDepth() };
+                }
+
+                m_stepperStale = true;
+                m_staleChildCount = iter-> second-> child.size();
+                return { iter-> second, getLevel (iter-> second) };
+            }
+
+            // add (or subtract) count to the number of descendants of the node and all its parents up to the root node
+            void updateDescendants (s_Node* node, size_t count, bool add) {
+                if (m_batchUpdate == true) {
+                    m_descendantsStale = true;
+                    return;
+                }
+
+                while (node != NULL) {
+                    if (add == true)
+                        node-> numDescendants += count;
+                    else
+                        node-> numDescendants -= count;
+                    node = node-> parent;
+                }
+            }
+
+            /* recompute the height of the node from its children, and carry the change up towards the root node. We stop
+             * at the first parent whose height doesn't change, so adding/removing a node in a bushy tree rarely goes far
+            */
+            void updateHeight (s_Node* node) {
+                if (m_batchUpdate == true) {
+                    m_descendantsStale = true;
+                    return;
+                }
+
+                while (node != NULL) {
+                    size_t height = 0;
+                    for (auto const& child : node-> child) {
+                        if (child != NULL)
+                            height = std::max (height, child-> height + 1);
+                    }
+
+                    if (height == node-> height)
+                        break;
+                    node-> height = height;
+                    node = node-> parent;
+                }
+            }
+
+            // recompute the descendant counts and heights of all nodes in the node/tree, children before their parents
+            void refreshDescendants (s_Node* rootNode) {
+                std::vector <s_Node*> preorder;
+                preorder.push_back (rootNode);
+
+                for (size_t i = 0; i < preorder.size(); i++) {
+                    for (auto const& child : preorder[i]-> child) {
+                        if (child != NULL)
+                            preorder.push_back (child);
+                    }
+                }
+
+                for (auto iter = preorder.rbegin(); iter != preorder.rend(); iter++) {
+                    s_Node* currentNode = *iter;
+                    currentNode-> numDescendants = 0;
+                    currentNode-> height = 0;
+
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL) {
+                            currentNode-> numDescendants += child-> numDescendants + 1;
+                            currentNode-> height = std::max (currentNode-> height, child-> height + 1);
+                        }
+                    }
+                }
+            }
+
+            inline void syncDescendants (void) {
+                if (m_descendantsStale == false)
+                    return;
+
+                if (m_rootNode != NULL)
+                    refreshDescendants (m_rootNode);
+                m_descendantsStale = false;
+            }
+
+            inline size_t getLevel (s_Node* node) {
+                return node-> level - m_levelBase;
+            }
+
+            inline void setLevel (s_Node* node, size_t level) {
+                node-> level = level + m_levelBase;
+            }
+
+            void countLevel (size_t level, bool add) {
+                if (add == true) {
+                    if (m_levelCount.size() < level)
+                        m_levelCount.resize (level, 0);
+                    m_levelCount[level - 1]++;
+                }
+                else {
+                    m_levelCount[level - 1]--;
+                    // trim empty levels at the bottom
+                    while (!m_levelCount.empty() && m_levelCount.back() == 0)
+                        m_levelCount.pop_back();
+                }
+            }
+
+            // add the node and its NULL children (if any) to the index and level count
+            void indexNode (s_Node* node) {
+                invalidateQueryCache();
+                m_nodeIndex[node-> id] = node;
+                countLevel (getLevel (node), true);
+
+                if (getPool (node) != m_nodePool)
+                    m_numForeignNodes++;
+
+                for (auto const& child : node-> child) {
+                    if (child == NULL)
+                        countLevel (getLevel (node) + 1, true);
+                }
+            }
+
+            /* add all nodes in the node/tree to the index, and set their levels with the root of the node/tree at the
+             * level passed in. A node/tree that is already in the index is moved to a new level using relevelTree()
+            */
+            void indexTree (s_Node* rootNode, size_t level) {
+                setLevel (rootNode, level);
+
+                std::queue <s_Node*> pendingQ;
+                pendingQ.push (rootNode);
+
+                while (!pendingQ.empty()) {
+                    s_Node* currentNode = pendingQ.front();
+                    pendingQ.pop();
+
+                    indexNode (currentNode);
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL) {
+                            child-> level = currentNode-> level + 1;
+                            pendingQ.push (child);
+                        }
+                    }
+                }
+            }
+
+            /* remove the node and its NULL children (if any) from the level count, and remove the index entry of the node
+             * unless the id has since been taken by a different node
+            */
+            void unindexNode (s_Node* node) {
+                invalidateQueryCache();
+                typename std::unordered_map <size_t, s_Node*>::iterator iter = m_nodeIndex.find (node-> id);
+                if (iter != m_nodeIndex.end() && iter-> second == node)
+                    m_nodeIndex.erase (iter);
+
+                for (auto const& child : node-> child) {
+                    if (child == NULL)
+                        countLevel (getLevel (node) + 1, false);
+                }
+                countLevel (getLevel (node), false);
+
+                if (getPool (node) != m_nodePool)
+                    m_numForeignNodes--;
+            }
+
+            void unindexTree (s_Node* rootNode) {
+                std::queue <s_Node*> pendingQ;
+                pendingQ.push (rootNode);
+
+                while (!pendingQ.empty()) {
+                    s_Node* currentNode = pendingQ.front();
+                    pendingQ.pop();
+
+                    unindexNode (currentNode);
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL)
+                            pendingQ.push (child);
+                    }
+                }
+            }
+
+            /* move a node/tree that is already in the index to a new level, with the root of the node/tree at the level
+             * passed in. The ids don't change, so only the levels and the level count are updated
+            */
+            void relevelTree (s_Node* rootNode, size_t level) {
+                size_t oldLevel = getLevel (rootNode);
+                if (oldLevel == level)
+                    return;
+
+                invalidateQueryCache();
+                std::queue <s_Node*> pendingQ;
+                pendingQ.push (rootNode);
+
+                while (!pendingQ.empty()) {
+                    s_Node* currentNode = pendingQ.front();
+                    pendingQ.pop();
+
+                    // every node in the node/tree moves by the same number of levels
+                    size_t currentLevel = getLevel (currentNode);
+                    size_t newLevel = currentLevel + level - oldLevel;
+                    countLevel (currentLevel, false);
+                    countLevel (newLevel, true);
+                    setLevel (currentNode, newLevel);
+
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL)
+                            pendingQ.push (child);
+                        else {
+                            countLevel (currentLevel + 1, false);
+                            countLevel (newLevel + 1, true);
+                        }
+                    }
+                }
+            }
+
+            /* link the nodes given their parent positions, createNodeAt (i) creates the node at position i. The children of
+             * every node are grouped with a counting sort (which keeps them in input order), and the nodes are created in
+             * level order once the input is known to be a single tree. Levels are set on the way down, and descendant
+             * counts and heights on the way back up
+            */
+            template <typename F>
+            s_Node* buildFromParents (const std::vector <size_t>& parents, F createNodeAt) {
+                size_t numNodes = parents.size();
+                size_t rootPosition = TREE_BUILD_NO_PARENT;
+                std::vector <size_t> childOffsets (numNodes + 1, 0);
+
+                for (size_t i = 0; i < numNodes; i++) {
+                    if (parents[i] == TREE_BUILD_NO_PARENT) {
+                        // more than one root
+                        if (rootPosition != TREE_BUILD_NO_PARENT)
+                            return NULL;
+                        rootPosition = i;
+                    }
+                    else if (parents[i] >= numNodes)
+                        return NULL;
+                    else
+                        childOffsets[parents[i] + 1]++;
+                }
+
+                if (rootPosition == TREE_BUILD_NO_PARENT)
+                    return NULL;
+
+                // children of node i are at [childOffsets[i], childOffsets[i + 1]) in the children vector
+                for (size_t i = 0; i < numNodes; i++)
+                    childOffsets[i + 1] += childOffsets[i];
+
+                std::vector <size_t> children (numNodes - 1);
+                std::vector <size_t> nextChild (childOffsets.begin(), childOffsets.end() - 1);
+                for (size_t i = 0; i < numNodes; i++) {
+                    if (parents[i] != TREE_BUILD_NO_PARENT)
+                        children[nextChild[parents[i]]++] = i;
+                }
+
+                // nodes that can't be reached from the root node are part of a cycle
+                std::vector <size_t> levelOrder;
+                levelOrder.reserve (numNodes);
+                levelOrder.push_back (rootPosition);
+
+                for (size_t k = 0; k < levelOrder.size(); k++) {
+                    size_t position = levelOrder[k];
+                    for (size_t c = childOffsets[position]; c < childOffsets[position + 1]; c++)
+                        levelOrder.push_back (children[c]);
+                }
+
+                if (levelOrder.size() != numNodes)
+                    return NULL;
+
+                std::vector <s_Node*> nodes (numNodes);
+                for (auto const& position : levelOrder)
+                    nodes[position] = createNodeAt (position);
+
+                setLevel (nodes[rootPosition], 1);
+                for (auto const& position : levelOrder) {
+                    s_Node* parentNode = nodes[position];
+                    for (size_t c = childOffsets[position]; c < childOffsets[position + 1]; c++) {
+                        s_Node* childNode = nodes[children[c]];
+
+                        parentNode-> child.push_back (childNode);
+                        childNode-> parent = parentNode;
+                        childNode-> level = parentNode-> level + 1;
+                    }
+                }
+
+                for (auto iter = levelOrder.rbegin(); iter != levelOrder.rend(); iter++) {
+                    s_Node* currentNode = nodes[*iter];
+                    s_Node* parentNode = currentNode-> parent;
+
+                    if (parentNode != NULL) {
+                        parentNode-> numDescendants += currentNode-> numDescendants + 1;
+                        parentNode-> height = std::max (parentNode-> height, currentNode-> height + 1);
+                    }
+                }
+                return nodes[rootPosition];
+            }
+
             /* node contents are displayed in the following pattern
              *      {                                           <L3>
              *          id : ?                                  <L4>
@@ -261,7 +838,248 @@ namespace Memory {
                 ost << CLOSE_L3;
             }
 
+            /* split the tree into subtree tasks for the parallel methods, using the descendant count of each node as the
+             * size hint. A node whose subtree is small enough becomes a task, otherwise it is added to topNodes (nodes
+             * that are left for the calling thread) and we look at its children instead. Tasks are sorted largest first,
+             * so that the workers picking tasks in order end up with a similar amount of work
+            */
+            void splitSubtrees (size_t numThreads, std::vector <s_Node*>& tasks, std::vector <s_Node*>& topNodes) {
+                size_t taskSize = std::max (getSize() / (numThreads * PARALLEL_FOLD_TASKS_PER_THREAD), 
+                                            static_cast <size_t> (PARALLEL_FOLD_MIN_NODES));
+
+                std::queue <s_Node*> pendingQ;
+                pendingQ.push (m_rootNode);
+
+                while (!pendingQ.empty()) {
+                    s_Node* currentNode = pendingQ.front();
+                    pendingQ.pop();
+
+                    if (currentNode-> numDescendants + 1 <= taskSize) {
+                        tasks.push_back (currentNode);
+                        continue;
+                    }
+
+                    topNodes.push_back (currentNode);
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL)
+                            pendingQ.push (child);
+                    }
+                }
+
+                std::sort (tasks.begin(), tasks.end(), [](s_Node* nodeA, s_Node* nodeB) {
+                    return nodeA-> numDescendants > nodeB-> numDescendants;
+                });
+            }
+
+            // run the tasks on numThreads threads, each thread picks the next task that is not taken yet till none is left
+            template <typename F>
+            static void runTasks (size_t numTasks, size_t numThreads, F&& task) {
+                std::atomic <size_t> nextTask (0);
+                std::vector <std::thread> workers;
+
+                for (size_t i = 0; i < std::min (numThreads, numTasks); i++)
+                    workers.emplace_back ([&nextTask, &task, numTasks]() {
+                        for (size_t idx = nextTask++; idx < numTasks; idx = nextTask++)
+                            task (idx);
+                    });
+
+                for (auto& worker : workers)
+                    worker.join();
+            }
+
+            /* fold a subtree in postorder on the calling thread, the lambda gets the data of a node along with the results
+             * of its (non NULL) children in order. If doneResults is passed in, nodes found in it are subtrees that have
+             * already been folded, so their result is used as it is instead of going into the subtree
+            */
+            template <typename R>
+            static R foldSubtree (s_Node* rootNode, 
+                                  R (*lambda) (T*, std::span <const R>), 
+                                  const std::unordered_map <s_Node*, R>* doneResults) {
+
+                // { node, next child index, position of the node's first child result in the results stack }
+                std::vector <std::tuple <s_Node*, size_t, size_t>> pendingStack;
+                std::vector <R> results;
+                pendingStack.push_back ({ rootNode, 0, 0 });
+
+                while (!pendingStack.empty()) {
+                    auto& [currentNode, childIdx, resultsBase] = pendingStack.back();
+
+                    if (childIdx < currentNode-> child.size()) {
+                        s_Node* childNode = currentNode-> child[childIdx++];
+                        if (childNode == NULL)
+                            continue;
+
+                        if (doneResults != NULL) {
+                            auto iter = doneResults-> find (childNode);
+                            if (iter != doneResults-> end()) {
+                                results.push_back (iter-> second);
+                                continue;
+                            }
+                        }
+                        pendingStack.push_back ({ childNode, 0, results.size() });
+                        continue;
+                    }
+
+                    // all children are done, replace their results with the result of this node
+                    R result = lambda (& (currentNode-> data), std::span <const R> (results.data() + resultsBase, 
+                                                                                    results.size() - resultsBase));
+                    results.erase (results.begin() + resultsBase, results.end());
+                    results.push_back (std::move (result));
+                    pendingStack.pop_back();
+                }
+                return std::move (results.back());
+            }
+
+            static void visitSubtree (s_Node* rootNode, void (*lambda) (T*)) {
+                std::vector <s_Node*> pendingStack;
+                pendingStack.push_back (rootNode);
+
+                while (!pendingStack.empty()) {
+                    s_Node* currentNode = pendingStack.back();
+                    pendingStack.pop_back();
+
+                    lambda (& (currentNode-> data));
+                    for (auto const& child : currentNode-> child) {
+                        if (child != NULL)
+                            pendingStack.push_back (child);
+                    }
+                }
+            }
+
         public:
+            /* immutable, flattened copy of the tree built by freeze(). Nodes are laid out in preorder with their links as
+             * 32 bit positions into the arrays below, and the payloads in an array of their own. Since a subtree in 
+             * preorder is a contiguous range of positions [position, subtreeEnd), subtree iteration is a walk over that
+             * range and ancestor tests are two comparisons.
+             * 
+             * The frozen tree is a copy, so it stays valid after the tree is updated or closed. NULL children are not
+             * part of the frozen tree
+            */
+            class Frozen {
+                private:
+                    std::vector <size_t> m_ids;
+                    std::vector <uint32_t> m_parents;
+                    std::vector <uint32_t> m_firstChildren;
+                    std::vector <uint32_t> m_nextSiblings;
+                    std::vector <uint32_t> m_subtreeEnds;
+                    std::vector <uint32_t> m_levels;
+                    std::vector <T> m_data;
+
+                    // { id, position } pairs sorted by id
+                    std::vector <std::pair <size_t, uint32_t>> m_positions;
+
+                    friend class Tree;
+
+                public:
+                    // an independent peek position in the frozen tree, starts at the root
+                    class Cursor {
+                        private:
+                            const Frozen* m_frozen;
+                            uint32_t m_position;
+
+                        public:
+                            Cursor (const Frozen* frozen, uint32_t position) {
+                                m_frozen = frozen;
+                                m_position = position;
+                            }
+
+                            inline void peekSet (size_t id) {
+                                m_position = m_frozen-> find (id);
+                            }
+
+                            inline void peekSetRoot (void) {
+                                m_position = (m_frozen-> getSize() == 0) ? TREE_FROZEN_NONE : 0;
+                            }
+
+                            inline void peekSetParent (void) {
+                                if (m_position != TREE_FROZEN_NONE)
+                                    m_position = m_frozen-> getParent (m_position);
+                            }
+
+                            inline void peekSetChild (void) {
+                                if (m_position != TREE_FROZEN_NONE)
+                                    m_position = m_frozen-> getFirstChild (m_position);
+                            }
+
+                            inline void peekSetNextSibling (void) {
+                                if (m_position != TREE_FROZEN_NONE)
+                                    m_position = m_frozen-> getNextSibling (m_position);
+                            }
+
+                            // next node in preorder
+                            inline void peekSetNext (void) {
+                                if (m_position != TREE_FROZEN_NONE)
+                                    m_position = (m_position + 1 == m_frozen-> getSize()) ? TREE_FROZEN_NONE : 
+                                                                                             m_position + 1;
+                            }
+
+                            inline bool peekIsEnd (void) const {
+                                return m_position == TREE_FROZEN_NONE;
+                            }
+
+                            inline uint32_t peekPosition (void) const {
+                                return m_position;
+                            }
+                    };
+
+                    inline size_t getSize (void) const {
+                        return m_ids.size();
+                    }
+
+                    // returns TREE_FROZEN_NONE if the id is not in the frozen tree
+                    uint32_t find (size_t id) const {
+                        auto iter = std::lower_bound (m_positions.begin(), m_positions.end(), 
+                                                      std::make_pair (id, static_cast <uint32_t> (0)));
+
+                        if (iter == m_positions.end() || iter-> first != id)
+                            return TREE_FROZEN_NONE;
+                        return iter-> second;
+                    }
+
+                    inline size_t getId (uint32_t position) const {
+                        return m_ids[position];
+                    }
+
+                    inline const T& getData (uint32_t position) const {
+                        return m_data[position];
+                    }
+
+                    inline uint32_t getLevel (uint32_t position) const {
+                        return m_levels[position];
+                    }
+
+                    inline uint32_t getParent (uint32_t position) const {
+                        return m_parents[position];
+                    }
+
+                    inline uint32_t getFirstChild (uint32_t position) const {
+                        return m_firstChildren[position];
+                    }
+
+                    inline uint32_t getNextSibling (uint32_t position) const {
+                        return m_nextSiblings[position];
+                    }
+
+                    // one past the last position in the subtree rooted at position
+                    inline uint32_t getSubtreeEnd (uint32_t position) const {
+                        return m_subtreeEnds[position];
+                    }
+
+                    // payloads of the node and all its descendants, in preorder
+                    inline std::span <const T> getSubtree (uint32_t position) const {
+                        return std::span <const T> (m_data.data() + position, m_subtreeEnds[position] - position);
+                    }
+
+                    // a node is considered to be an ancestor of itself
+                    inline bool isAncestor (uint32_t positionA, uint32_t positionB) const {
+                        return positionA <= positionB && positionB < m_subtreeEnds[positionA];
+                    }
+
+                    inline Cursor getCursor (void) const {
+                        return Cursor (this, (getSize() == 0) ? TREE_FROZEN_NONE : 0);
+                    }
+            };
+
             Tree (size_t instanceId) {
                 m_rootNode     = NULL;
                 m_instanceId   = instanceId;
@@ -269,16 +1087,34 @@ namespace Memory {
                 resetPeek();
                 m_savePeek     = { NULL, 0 };
                 m_nodesInLevel = 0;
+                m_stepperStale = false;
+                m_staleChildCount = 0;
+
+                m_levelBase = 0;
+
+                m_nodePool = new NodePool();
+                m_numForeignNodes = 0;
+
+                m_batchUpdate = false;
+                m_descendantsStale = false;
+                m_lcaIndex.isValid = false;
+                m_tailsStale = true;
+                m_deepestNode = NULL;
             }
 
             ~Tree (void) {
                 // destroy all nodes
                 peekSetRoot();
                 remove();
+
+                // nodes adopted from this tree may still be alive in other trees
+                m_nodePool-> setOwnerClosed();
+                if (m_nodePool-> getNumNodes() == 0)
+                    delete m_nodePool;
             }
 
             /* sticky peek pair set to
-             * { node, level }  -> if valid id
+             * { node, level }  -> if valid id, O(1) through the node index
              * { NULL, depth }  -> otherwise
             */
             inline void peekSet (size_t id) {
@@ -293,6 +1129,7 @@ namespace Memory {
                 // force reset queue
                 stepperReset();
                 stepperStart();
+                m_stepperStale = false;
 
                 /* instead of setting peek node to root node directly, we use the stepper to set it for us (same as in the
                  * peekSet method). This allows us to use peekSetNext method afterwards
@@ -345,6 +1182,18 @@ namespace Memory {
              * {3, 30} is now at level=3 which would be different from the results from peek methods
             */
             void peekSetNext (void) {
+                /* peek was set through the index, rebuild the stepper queue up to the peek node so that we continue the
+                 * level order traversal from there
+                */
+                if (m_stepperStale == true && peekNode() != NULL) {
+                    s_Node* currentNode = peekNode();
+                    stepperSeek (currentNode-> id);
+
+                    // the children of the peek node are at the back of the queue
+                    if (currentNode-> child.size() > m_staleChildCount)
+                        m_stepperQueue.resize (m_stepperQueue.size() - currentNode-> child.size() + m_staleChildCount);
+                }
+
                 /* ret could be either of the following:
                  * { false { NULL, true } }     -> update level count
                  * { false { node, false } }    -> we have a node (could be a NULL node)
@@ -399,14 +1248,13 @@ namespace Memory {
 
                 s_Node* newNode = createNode (id, data);
                 // update number of descendants of all parents up to the root node
-                s_Node* tempNode = parentNode;
-                while (tempNode != NULL) {
-                    tempNode-> numDescendants++;
-                    tempNode = tempNode-> parent;
-                }
+                updateDescendants (parentNode, 1, true);
 
                 parentNode-> child.push_back (newNode);
                 newNode-> parent = parentNode;
+                newNode-> level = parentNode-> level + 1;
+                indexNode (newNode);
+                updateHeight (parentNode);
                 return true; 
             } 
 
@@ -430,6 +1278,7 @@ namespace Memory {
                     return false;
 
                 parentNode-> child.push_back (NULL);
+                countLevel (getLevel (parentNode) + 1, true);
                 return true;
             }
 
@@ -445,14 +1294,12 @@ namespace Memory {
                     return false;
 
                 // update number of descendants of all parents upto root node
-                s_Node* tempNode = parentNode;
-                while (tempNode != NULL) {
-                    tempNode-> numDescendants += rootNode-> numDescendants + 1;
-                    tempNode = tempNode-> parent;
-                }
+                updateDescendants (parentNode, rootNode-> numDescendants + 1, true);
 
                 parentNode-> child.push_back (rootNode);
                 rootNode-> parent = parentNode;
+                indexTree (rootNode, getLevel (parentNode) + 1);
+                updateHeight (parentNode);
                 return true;
             }
 
@@ -473,12 +1320,11 @@ namespace Memory {
                 }
 
                 /* adding a parent to childNode is done through the following steps
-                 * (1) add new node (acts as parent to adopted node/tree) using addChild() (note that the new node will
-                 *     be added to end of the parent's child vector)
-                 * (2) save the position of childNode in parent's child vector
-                 * (3) change position of newly added node from back of the vector to saved position from (2)
-                 * (4) remove (with adopt) the childNode (and its descendants)
-                 * (5) append the adopted node/tree from (4) to the newly added node
+                 * (1) add new node (acts as parent to childNode) using addChild() (note that the new node will be added
+                 *     to end of the parent's child vector)
+                 * (2) move the newly added node from back of the vector to childNode's position in the vector
+                 * (3) link childNode (and its descendants) as the only child of the newly added node
+                 * (4) move childNode (and its descendants) down by a level, they stay in the index as is
                 */
                 s_Node* parentNode = childNode-> parent;
 
@@ -487,23 +1333,21 @@ namespace Memory {
                 addChild (id, data);  
 
                 // (2)
-                typename std::vector <s_Node*>::iterator iter;
-                iter = std::find (parentNode-> child.begin(), 
-                                  parentNode-> child.end(), 
-                                  childNode);
-
-                // (3)
                 s_Node* newNode = parentNode-> child.back();
                 parentNode-> child.pop_back();
-                parentNode-> child.insert (iter, newNode);
+                *std::find (parentNode-> child.begin(), parentNode-> child.end(), childNode) = newNode;
 
-                // (4) 
-                peekSet (childNode-> id);
-                s_Node* rootNode = remove (true).first;
+                // (3) the parents of newNode already count childNode and its descendants
+                newNode-> child.push_back (childNode);
+                childNode-> parent = newNode;
+                newNode-> numDescendants = childNode-> numDescendants + 1;
+
+                // (4)
+                relevelTree (childNode, getLevel (newNode) + 1);
+                updateHeight (newNode);
 
-                // (5)
                 peekSet (id);
-                return appendTree (rootNode);        
+                return true;
             }
 
             /* this is different from the remove() method, as in removeNode() removes/adopts only a single node. When you
@@ -526,19 +1370,17 @@ namespace Memory {
                     return { NULL, false };
 
                 s_Node* parentNode = currentNode-> parent;
+                // only currentNode leaves the index, its descendants stay and are moved up a level below
+                unindexNode (currentNode);
                 
                 // save position of currentNode in parent's child vector
-                typename std::vector <s_Node*>::iterator iter;
+                typename ChildVector <s_Node*, N>::iterator iter;
                 iter = std::find (parentNode-> child.begin(),
                                   parentNode-> child.end(),
                                   currentNode);
 
                 // update descendants of all parents upto root node
-                s_Node* tempNode = parentNode;
-                while (tempNode != NULL) {
-                    tempNode-> numDescendants -= 1;
-                    tempNode = tempNode-> parent;
-                }
+                updateDescendants (parentNode, 1, false);
 
                 // add child of currentNode as parentNode's children
                 parentNode-> child.insert (iter, currentNode-> child.begin(),
@@ -550,14 +1392,20 @@ namespace Memory {
                                                        currentNode),
                                           parentNode-> child.end());
 
-                // set parent of new children
+                // set parent of new children, and move them (and their descendants) up by a level
                 for (auto const& child : currentNode-> child) {
-                    if (child != NULL)
+                    if (child != NULL) {
                         child-> parent = parentNode;
+                        relevelTree (child, getLevel (parentNode) + 1);
+                    }
+                    else
+                        countLevel (getLevel (parentNode) + 1, true);
                 }
+                updateHeight (parentNode);
 
                 // clear currentNode stats
                 currentNode-> numDescendants = 0;
+                currentNode-> height = 0;
                 currentNode-> parent = NULL;
                 currentNode-> child.clear();
 
@@ -566,7 +1414,7 @@ namespace Memory {
                 if (adopt == true) 
                     return { currentNode, true };
                 else {
-                    delete currentNode;
+                    destroyNode (currentNode);
                     return { NULL, true };
                 }
             }
@@ -588,31 +1436,66 @@ namespace Memory {
                 if (currentNode == NULL) 
                     return { NULL, false };
 
+                // the descendant counts of the node/tree going out are either returned with it or used below
+                if (m_descendantsStale == true)
+                    refreshDescendants (currentNode);
+
                 // if NOI (node of interest) is not a root node
-                if (currentNode != m_rootNode) {
+                bool isRootNode = (currentNode == m_rootNode);
+                if (isRootNode == false) {
                     s_Node* parentNode = currentNode-> parent;
 
                     // update descendants of all parents upto root node
-                    s_Node* tempNode = parentNode;
-                    while (tempNode != NULL) {
-                        tempNode-> numDescendants -= currentNode-> numDescendants + 1;
-                        tempNode = tempNode-> parent;
-                    }
+                    updateDescendants (parentNode, currentNode-> numDescendants + 1, false);
 
                     parentNode-> child.erase (std::remove (parentNode-> child.begin(), 
                                                            parentNode-> child.end(), 
                                                            currentNode),
                                               parentNode-> child.end());
                     currentNode-> parent = NULL;
+                    updateHeight (parentNode);
                 }
                 else
                     m_rootNode = NULL;
 
                 if (adopt == true) {
+                    unindexTree (currentNode);
                     resetPeek();
                     return { currentNode, true };
                 }
 
+                /* the whole tree is being removed and every live node in our pool is in this tree, so we can skip the
+                 * node by node free and release the pool's blocks at once (only the data destructors need a walk)
+                */
+                else if (isRootNode == true && m_numForeignNodes == 0 && 
+                         m_nodePool-> getNumNodes() == currentNode-> numDescendants + 1) {
+
+                    if constexpr (!std::is_trivially_destructible <T>::value) {
+                        std::queue <s_Node*> pendingQ;
+                        pendingQ.push (currentNode);
+
+                        while (!pendingQ.empty()) {
+                            s_Node* currentNode = pendingQ.front();
+                            pendingQ.pop();
+
+                            for (auto const& child : currentNode-> child) {
+                                if (child != NULL)
+                                    pendingQ.push (child);
+                            }
+                            currentNode-> ~s_Node();
+                        }
+                    }
+
+                    m_nodeIndex.clear();
+                    m_levelCount.clear();
+                    invalidateQueryCache();
+
+                    m_nodePool-> releaseNodes();
+
+                    resetPeek();
+                    return { NULL, true };
+                }
+
                 else {
                     // we cannot use the stepper here because we need depth traversal to remove node and its children
                     std::queue <s_Node*> pendingQ;
@@ -629,7 +1512,8 @@ namespace Memory {
                                 pendingQ.push (child);
                         }
 
-                        delete currentNode;
+                        unindexNode (currentNode);
+                        destroyNode (currentNode);
                     }
 
                     resetPeek();
@@ -644,10 +1528,17 @@ namespace Memory {
                     newNode-> numDescendants = m_rootNode-> numDescendants + 1;
                     newNode-> child.push_back (m_rootNode);
                     m_rootNode-> parent = newNode;
+
+                    // every existing node moves down by a level, in O(1) by moving the level base and the level count
+                    m_levelBase--;
+                    m_levelCount.insert (m_levelCount.begin(), 0);
                 }
 
                 // update root node
                 m_rootNode = newNode;
+                setLevel (m_rootNode, 1);
+                indexNode (m_rootNode);
+                updateHeight (m_rootNode);
             }
 
             bool swap (size_t idA, size_t idB) {
@@ -669,6 +1560,7 @@ namespace Memory {
                     restorePeek();
                     return true;
                 }
+                invalidateQueryCache();
 
                 /* there are 2 special cases where our swap operation fails
                  * (1) when nodeA is the immediate parent of nodeB
@@ -692,7 +1584,7 @@ namespace Memory {
                  * 2 : child's parent pointer
                  * 3 : NOI's parent pointer
                  * 4 : NOI's child vector
-                 * 5 : descendants count
+                 * 5 : descendants count and level
                  * 6 : update saved variables : root node update if changed. In case of peek vars, you can keep it as it is
                  * even though some params might be different after the swap operation
                 */
@@ -702,7 +1594,7 @@ namespace Memory {
                 s_Node* parentNodeB = nodeB-> parent;
 
                 // swap child in parent's child vector (order of the child in the vector is retained)
-                typedef typename std::vector <s_Node*>::iterator iter;
+                typedef typename ChildVector <s_Node*, N>::iterator iter;
                 iter itA, itB;
 
                 if (parentNodeA != NULL)
@@ -744,7 +1636,7 @@ namespace Memory {
                 nodeA-> parent = parentNodeB;
 
                 // (4) 
-                std::vector <s_Node*> tempVec = nodeA-> child;
+                ChildVector <s_Node*, N> tempVec (nodeA-> child, nodeA-> child.getResource());
                 nodeA-> child = nodeB-> child;
                 nodeB-> child = tempVec;
 
@@ -753,6 +1645,15 @@ namespace Memory {
                 nodeA-> numDescendants = nodeB-> numDescendants;
                 nodeB-> numDescendants = tempVar;
 
+                // the nodes trade places, so their levels and heights are swapped as well
+                tempVar = nodeA-> level;
+                nodeA-> level = nodeB-> level;
+                nodeB-> level = tempVar;
+
+                tempVar = nodeA-> height;
+                nodeA-> height = nodeB-> height;
+                nodeB-> height = tempVar;
+
                 // (6) 
                 m_rootNode = (nodeA-> parent == NULL) ? nodeA :
                              (nodeB-> parent == NULL) ? nodeB :
@@ -776,21 +1677,114 @@ namespace Memory {
                 peekSetRoot();
                 remove();
                 m_rootNode = rootNode;
+
+                if (m_rootNode != NULL)
+                    indexTree (m_rootNode, 1);
+            }
+
+            /* build a tree from (id, parent id, data) tuples given in any order, in O(n). The root node is the one with
+             * TREE_BUILD_NO_PARENT as its parent id, and siblings are added in the order they appear in the input. The nodes
+             * are allocated from this tree's pool, but they are not a part of the tree till the returned root node is 
+             * imported using importTree(). Till then they count as live nodes of the pool, which keeps remove() from
+             * releasing the pool's blocks all at once. Like an adopted node/tree, a built tree has to be imported (or
+             * appended) somewhere for its nodes to be freed; the pool outlives the tree till they are
+             * 
+             * returns NULL (and allocates nothing) if the input doesn't form a single tree, i.e. if there is no root node 
+             * or more than one, an id is repeated, a parent id is not in the input or the parent links form a cycle
+            */
+            s_Node* buildTree (const std::vector <std::tuple <size_t, size_t, T>>& input) {
+                std::unordered_map <size_t, size_t> positions;
+                positions.reserve (input.size());
+
+                for (size_t i = 0; i < input.size(); i++) {
+                    // repeated id
+                    if (positions.emplace (std::get <0> (input[i]), i).second == false)
+                        return NULL;
+                }
+
+                // replace parent ids with their position in the input
+                std::vector <size_t> parents (input.size());
+                for (size_t i = 0; i < input.size(); i++) {
+                    size_t parentId = std::get <1> (input[i]);
+                    if (parentId == TREE_BUILD_NO_PARENT) {
+                        parents[i] = TREE_BUILD_NO_PARENT;
+                        continue;
+                    }
+
+                    auto iter = positions.find (parentId);
+                    if (iter == positions.end())
+                        return NULL;
+                    parents[i] = iter-> second;
+                }
+
+                return buildFromParents (parents, [&](size_t i) {
+                    return createNode (std::get <0> (input[i]), std::get <2> (input[i]));
+                });
+            }
+
+            /* same as above, from a parent index array where node i (with id i and data[i]) is a child of node parents[i],
+             * and the root node has TREE_BUILD_NO_PARENT as its parent index
+            */
+            s_Node* buildTree (const std::vector <size_t>& parents, const std::vector <T>& data) {
+                if (parents.size() != data.size())
+                    return NULL;
+
+                return buildFromParents (parents, [&](size_t i) {
+                    return createNode (i, data[i]);
+                });
+            }
+
+            /* start a batch update, adding/removing nodes in a batch doesn't update the descendant counts of the parents
+             * (making a tree build O(n) instead of O(n * depth)). Note that the descendant counts of the nodes shouldn't
+             * be read directly till the batch is committed, getSize() is fine
+            */
+            inline void beginBatch (void) {
+                m_batchUpdate = true;
+            }
+
+            // recompute all descendant counts in one pass, and go back to updating them on every add/remove
+            void commitBatch (void) {
+                m_batchUpdate = false;
+                syncDescendants();
             }
 
             inline size_t getSize (void) {
+                syncDescendants();
                 return (m_rootNode == NULL) ? 0 : m_rootNode-> numDescendants + 1;
             }
 
-            // pass an id that doesn't exist (reserved id) in tree to get depth
-            size_t getDepth (void) {
-                savePeek();
+            // depth is the number of levels in the tree, including a level that has only NULL children
+            inline size_t getDepth (void) {
+                return m_levelCount.size();
+            }
 
-                peekSet (RESERVED_0);
-                size_t depth = peekLevel();
+            /* lowest common ancestor of the two nodes (a node is considered to be an ancestor of itself), or NULL if either
+             * of the ids is invalid. Queries are O(1) once the LCA index is built, and the index is rebuilt (O(n log n)) on
+             * the first query after the tree was updated, so batch the queries together
+            */
+            s_Node* getLCA (size_t idA, size_t idB) {
+                std::pair <uint32_t, bool> positionA = getLcaPosition (idA);
+                std::pair <uint32_t, bool> positionB = getLcaPosition (idB);
+                if (positionA.second == false || positionB.second == false)
+                    return NULL;
+
+                uint32_t first = std::min (positionA.first, positionB.first);
+                uint32_t last  = std::max (positionA.first, positionB.first);
+                // first is an ancestor of last (or both are the same node)
+                if (last < m_lcaIndex.subtreeEnds[first])
+                    return m_lcaIndex.nodes[first];
+
+                return m_lcaIndex.nodes[lowestInRange (first + 1, last)]-> parent;
+            }
 
-                restorePeek();
-                return depth;
+            // returns true if A is an ancestor of B (or A is B), uses the LCA index
+            bool isAncestor (size_t idA, size_t idB) {
+                std::pair <uint32_t, bool> positionA = getLcaPosition (idA);
+                std::pair <uint32_t, bool> positionB = getLcaPosition (idB);
+                if (positionA.second == false || positionB.second == false)
+                    return false;
+
+                return positionA.first <= positionB.first && positionB.first < m_lcaIndex.subtreeEnds[positionA.first];
             }
 
             std::vector <size_t> getPath (size_t idA, size_t idB) {
@@ -862,24 +1856,155 @@ namespace Memory {
                 return lowerPath;
             }
 
+            Frozen freeze (void) {
+                Frozen frozen;
+                size_t numNodes = getSize();
+                if (numNodes == 0)
+                    return frozen;
+
+                assert (numNodes < TREE_FROZEN_NONE);
+                frozen.m_ids.reserve           (numNodes);
+                frozen.m_parents.reserve       (numNodes);
+                frozen.m_firstChildren.reserve (numNodes);
+                frozen.m_nextSiblings.reserve  (numNodes);
+                frozen.m_levels.reserve        (numNodes);
+                frozen.m_data.reserve          (numNodes);
+
+                // last child added so far for every position, used to link up the next sibling
+                std::vector <uint32_t> lastChildren;
+                lastChildren.reserve (numNodes);
+
+                // depth first, { node, parent position } pairs
+                std::vector <std::pair <s_Node*, uint32_t>> pendingStack;
+                pendingStack.push_back ({ m_rootNode, TREE_FROZEN_NONE });
+
+                while (!pendingStack.empty()) {
+                    auto [currentNode, parentPosition] = pendingStack.back();
+                    pendingStack.pop_back();
+
+                    uint32_t position = static_cast <uint32_t> (frozen.m_ids.size());
+                    frozen.m_ids.push_back           (currentNode-> id);
+                    frozen.m_parents.push_back       (parentPosition);
+                    frozen.m_firstChildren.push_back (TREE_FROZEN_NONE);
+                    frozen.m_nextSiblings.push_back  (TREE_FROZEN_NONE);
+                    frozen.m_levels.push_back        (static_cast <uint32_t> (getLevel (currentNode)));
+                    frozen.m_data.push_back          (currentNode-> data);
+                    lastChildren.push_back           (TREE_FROZEN_NONE);
+
+                    if (parentPosition != TREE_FROZEN_NONE) {
+                        if (lastChildren[parentPosition] == TREE_FROZEN_NONE)
+                            frozen.m_firstChildren[parentPosition] = position;
+                        else
+                            frozen.m_nextSiblings[lastChildren[parentPosition]] = position;
+                        lastChildren[parentPosition] = position;
+                    }
+
+                    // push in reverse so that the children are visited in order
+                    for (auto iter = currentNode-> child.end(); iter != currentNode-> child.begin();) {
+                        --iter;
+                        if (*iter != NULL)
+                            pendingStack.push_back ({ *iter, position });
+                    }
+                }
+
+                // subtree ends, bottom up (every child comes after its parent in preorder)
+                frozen.m_subtreeEnds.resize (numNodes);
+                for (uint32_t position = static_cast <uint32_t> (numNodes); position-- > 0;) {
+                    uint32_t subtreeEnd = std::max (frozen.m_subtreeEnds[position], position + 1);
+                    frozen.m_subtreeEnds[position] = subtreeEnd;
+
+                    uint32_t parentPosition = frozen.m_parents[position];
+                    if (parentPosition != TREE_FROZEN_NONE)
+                        frozen.m_subtreeEnds[parentPosition] = std::max (frozen.m_subtreeEnds[parentPosition], 
+                                                                         subtreeEnd);
+                }
+
+                frozen.m_positions.reserve (numNodes);
+                for (uint32_t position = 0; position < numNodes; position++)
+                    frozen.m_positions.push_back ({ frozen.m_ids[position], position });
+                std::sort (frozen.m_positions.begin(), frozen.m_positions.end());
+
+                return frozen;
+            }
+
+            /* fold the tree bottom up, the lambda gets the data of a node and the results of its children (in order) and 
+             * returns the result for the node; the result of the root node is returned. Subtrees are folded in parallel on
+             * numThreads threads, and the nodes above them are then folded on the calling thread using their results.
+             * Note that the lambda will be called from multiple threads at once, each node is visited exactly once though,
+             * so the lambda may update the data of the node it is called with (for example, to store per subtree rollups)
+             * 
+             * R should be default constructible, and bool is not supported (no contiguous std::vector <bool>)
+            */
+            template <typename R>
+            R foldParallel (size_t numThreads, R (*lambda) (T*, std::span <const R>)) {
+                static_assert (!std::is_same <R, bool>::value, "fold result can't be bool");
+                if (m_rootNode == NULL)
+                    return R();
+
+                if (numThreads < 2 || getSize() < numThreads * PARALLEL_FOLD_MIN_NODES)
+                    return foldSubtree <R> (m_rootNode, lambda, NULL);
+
+                std::vector <s_Node*> tasks, topNodes;
+                splitSubtrees (numThreads, tasks, topNodes);
+
+                std::vector <R> taskResults (tasks.size());
+                runTasks (tasks.size(), numThreads, [&tasks, &taskResults, lambda](size_t idx) {
+                    taskResults[idx] = foldSubtree <R> (tasks[idx], lambda, NULL);
+                });
+
+                std::unordered_map <s_Node*, R> doneResults;
+                for (size_t i = 0; i < tasks.size(); i++)
+                    doneResults.insert ({ tasks[i], std::move (taskResults[i]) });
+
+                return foldSubtree <R> (m_rootNode, lambda, &doneResults);
+            }
+
+            /* call the lambda on every node in the tree in no particular order, on numThreads threads. Same as the fold 
+             * above, the lambda will be called from multiple threads at once
+            */
+            void visitParallel (size_t numThreads, void (*lambda) (T*)) {
+                if (m_rootNode == NULL)
+                    return;
+
+                if (numThreads < 2 || getSize() < numThreads * PARALLEL_FOLD_MIN_NODES) {
+                    visitSubtree (m_rootNode, lambda);
+                    return;
+                }
+
+                std::vector <s_Node*> tasks, topNodes;
+                splitSubtrees (numThreads, tasks, topNodes);
+
+                runTasks (tasks.size(), numThreads, [&tasks, lambda](size_t idx) {
+                    visitSubtree (tasks[idx], lambda);
+                });
+
+                for (auto const& node : topNodes)
+                    lambda (& (node-> data));
+            }
+
+            // tail ids in level order, the level order walk is only done on the first call after the tree was updated
             std::vector <size_t> getTails (void) {
                 if (m_rootNode == NULL)
                     return { };
 
+                if (m_tailsStale == false)
+                    return m_tails;
+
                 savePeek();
 
-                std::vector <size_t> tails;
+                m_tails.clear();
                 peekSetRoot();
                 while (!peekIsEnd()) {
                     // return all node ids with child count/descendant count = 0
                     if (peekNode() != NULL && peekChildCount() == 0)
-                        tails.push_back (peekNode()-> id);
+                        m_tails.push_back (peekNode()-> id);
 
                     peekSetNext();
                 }
 
                 restorePeek();
-                return tails;
+                m_tailsStale = false;
+                return m_tails;
             }
 
             /* tree is displayed in the following format
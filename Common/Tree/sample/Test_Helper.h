@@ -51,8 +51,8 @@ typedef struct {
  * 
  * [*]  -> these methods are only called when the tree is non-empty
 */
-template <typename T>
-bool verifyTree (Memory::Tree <T>* tree, s_groundTruth params) {
+template <typename T, size_t N>
+bool verifyTree (Memory::Tree <T, N>* tree, s_groundTruth params) {
     if (tree-> TREE_SIZE    != params.numNodes ||   
         tree-> TREE_DEPTH   != params.depth)
         return false;
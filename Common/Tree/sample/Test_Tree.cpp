@@ -14,6 +14,9 @@
 #include "../inc/Tree.h"
 #include "../../LibTest/inc/LibTest.h"
 #include "Test_Helper.h"
+#include <random>
+#include <numeric>
+#include <unordered_set>
 
 using namespace Collections;
 
@@ -2185,6 +2188,831 @@ LIB_TEST_CASE (22, "tail node id on 1 node tree") {
     return Quality::Test::PASS;  
 }
 
+LIB_TEST_CASE (23, "peek set through node index") {
+    auto myTree = TREE_INIT (23, int);
+    std::pair <size_t, int> input[] = { { 1, 10 }, { 2, 20 }, { 3, 30 }, { 4, 40 }, { 5, 50 }, { 6, 60 } };
+
+    // create tree
+    myTree-> TREE_ADD_ROOT (input[1].first, input[1].second);
+    myTree-> TREE_PEEK_SET (2);
+    myTree-> TREE_ADD_CHILD (input[2].first, input[2].second);
+    myTree-> TREE_ADD_CHILD (input[3].first, input[3].second);
+    myTree-> TREE_PEEK_SET (3);
+    myTree-> TREE_ADD_CHILD (input[4].first, input[4].second);
+    // every existing node moves down by a level
+    myTree-> TREE_ADD_ROOT (input[0].first, input[0].second);
+
+    /*                                  {1, 10}
+     *                                  |
+     *                                  {2, 20}
+     *                                  |
+     *                          -----------------
+     *                          |               |
+     *                          {3, 30}         {4, 40}
+     *                          |
+     *                          {5, 50}
+    */
+    size_t levels[] = { 1, 2, 3, 3, 4 };
+    for (size_t i = 0; i < 5; i++) {
+        myTree-> TREE_PEEK_SET (input[i].first);
+        if (myTree-> TREE_PEEK_NODE-> data != input[i].second || myTree-> TREE_PEEK_LEVEL != levels[i])
+            return Quality::Test::FAIL;
+    }
+
+    // level order traversal continues from the peek node
+    myTree-> TREE_PEEK_SET (3);
+    myTree-> TREE_PEEK_SET_NEXT;
+    if (myTree-> TREE_PEEK_NODE-> id != 4 || myTree-> TREE_PEEK_LEVEL != 3)
+        return Quality::Test::FAIL;
+    myTree-> TREE_PEEK_SET_NEXT;
+    if (myTree-> TREE_PEEK_NODE-> id != 5 || myTree-> TREE_PEEK_LEVEL != 4)
+        return Quality::Test::FAIL;
+
+    // adopted nodes are no longer reachable through peek set
+    myTree-> TREE_PEEK_SET (3);
+    auto adoptedNode = myTree-> TREE_ADOPT.first;
+    myTree-> TREE_PEEK_SET (5);
+    if (myTree-> TREE_PEEK_NODE != NULL || myTree-> TREE_PEEK_LEVEL != 3)
+        return Quality::Test::FAIL;
+
+    // appended nodes pick up their new levels
+    myTree-> TREE_PEEK_SET (4);
+    myTree-> TREE_APPEND (adoptedNode);
+    myTree-> TREE_PEEK_SET (5);
+    if (myTree-> TREE_PEEK_NODE == NULL || myTree-> TREE_PEEK_LEVEL != 5)
+        return Quality::Test::FAIL;
+
+    // removing a single node moves its children up
+    myTree-> TREE_PEEK_SET (3);
+    myTree-> TREE_REMOVE_NODE;
+    myTree-> TREE_PEEK_SET (3);
+    if (myTree-> TREE_PEEK_NODE != NULL)
+        return Quality::Test::FAIL;
+    myTree-> TREE_PEEK_SET (5);
+    if (myTree-> TREE_PEEK_LEVEL != 4 || myTree-> TREE_PEEK_NODE-> parent-> id != 4)
+        return Quality::Test::FAIL;
+
+    // swapping nodes swaps their levels
+    myTree-> TREE_SWAP (2, 5);
+    myTree-> TREE_PEEK_SET (2);
+    if (myTree-> TREE_PEEK_LEVEL != 4)
+        return Quality::Test::FAIL;
+    myTree-> TREE_PEEK_SET (5);
+    if (myTree-> TREE_PEEK_LEVEL != 2 || myTree-> TREE_PEEK_NODE-> parent-> id != 1)
+        return Quality::Test::FAIL;
+
+    // adding a parent moves the subtree down
+    myTree-> TREE_PEEK_SET (4);
+    myTree-> TREE_ADD_PARENT (input[5].first, input[5].second);
+    myTree-> TREE_PEEK_SET (2);
+    if (myTree-> TREE_PEEK_LEVEL != 5)
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_RESET;
+    myTree-> TREE_PEEK_SET (1);
+    if (myTree-> TREE_PEEK_NODE != NULL || myTree-> TREE_SIZE != 0)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (23);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (24, "depth maintained across tree updates") {
+    auto myTree = TREE_INIT (24, int);
+    std::mt19937 generator (24);
+    size_t nextId = 1;
+
+    myTree-> TREE_ADD_ROOT (nextId, 0);
+    nextId++;
+
+    for (size_t i = 0; i < 2000; i++) {
+        // collect node ids and the depth of tree using a level order traversal
+        std::vector <size_t> ids;
+        size_t depth = 0;
+        myTree-> TREE_PEEK_SET_ROOT;
+        while (!myTree-> TREE_PEEK_IS_END) {
+            if (myTree-> TREE_PEEK_NODE != NULL)
+                ids.push_back (myTree-> TREE_PEEK_NODE-> id);
+            depth = std::max (depth, myTree-> TREE_PEEK_LEVEL);
+            myTree-> TREE_PEEK_SET_NEXT;
+        }
+
+        if (myTree-> TREE_DEPTH != depth || myTree-> TREE_SIZE != ids.size())
+            return Quality::Test::FAIL;
+
+        // invalid id reports depth
+        myTree-> TREE_PEEK_SET (RESERVED_0);
+        if (myTree-> TREE_PEEK_NODE != NULL || myTree-> TREE_PEEK_LEVEL != depth)
+            return Quality::Test::FAIL;
+
+        if (ids.empty()) {
+            myTree-> TREE_ADD_ROOT (nextId, 0);
+            nextId++;
+            continue;
+        }
+
+        size_t idA = ids[generator() % ids.size()];
+        size_t idB = ids[generator() % ids.size()];
+        myTree-> TREE_PEEK_SET (idA);
+
+        // grow more often than shrink
+        switch (generator() % 10) {
+            case 0:
+            case 1:
+            case 2:
+                myTree-> TREE_ADD_CHILD (nextId, 0);
+                nextId++;
+                break;
+            case 3:
+                myTree-> TREE_ADD_NULL_CHILD;
+                break;
+            case 4:
+                myTree-> TREE_ADD_PARENT (nextId, 0);
+                nextId++;
+                break;
+            case 5:
+                myTree-> TREE_ADD_ROOT (nextId, 0);
+                nextId++;
+                break;
+            case 6:
+                myTree-> TREE_REMOVE_NODE;
+                break;
+            case 7:
+                if (generator() % 4 == 0)
+                    myTree-> TREE_REMOVE;
+                break;
+            case 8: {
+                // move node/tree under another node that is not in the node/tree
+                myTree-> TREE_PEEK_SET (idB);
+                auto node = myTree-> TREE_PEEK_NODE;
+                while (node != NULL && node-> id != idA)
+                    node = node-> parent;
+                if (node != NULL)
+                    break;
+
+                myTree-> TREE_PEEK_SET (idA);
+                auto adoptedNode = myTree-> TREE_ADOPT.first;
+                myTree-> TREE_PEEK_SET (idB);
+                myTree-> TREE_APPEND (adoptedNode);
+                break;
+            }
+            default:
+                myTree-> TREE_SWAP (idA, idB);
+                break;
+        }
+    }
+
+    TREE_CLOSE (24);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (25, "pool allocated nodes outlive their tree") {
+    auto myTree = TREE_INIT (25, std::string);
+    auto adoptor = TREE_INIT (26, std::string);
+
+    // two rounds, the second one reuses the pool after a reset
+    for (size_t round = 0; round < 2; round++) {
+        myTree-> TREE_ADD_ROOT (1, "1");
+        for (size_t id = 2; id <= 1000; id++) {
+            myTree-> TREE_PEEK_SET (id / 4 + 1);
+            myTree-> TREE_ADD_CHILD (id, std::to_string (id));
+        }
+
+        if (myTree-> TREE_SIZE != 1000)
+            return Quality::Test::FAIL;
+
+        if (round == 0)
+            myTree-> TREE_RESET;
+    }
+
+    /* adopt a subtree into another tree, and close the tree that allocated the nodes before the adoptor is done with
+     * them
+    */
+    myTree-> TREE_PEEK_SET (2);
+    adoptor-> TREE_IMPORT (myTree-> TREE_ADOPT.first);
+    size_t adoptedSize = adoptor-> TREE_SIZE;
+    TREE_CLOSE (25);
+
+    if (adoptedSize == 0 || adoptor-> TREE_SIZE != adoptedSize)
+        return Quality::Test::FAIL;
+
+    // nodes allocated by the adoptor are mixed in with the adopted nodes
+    adoptor-> TREE_PEEK_SET (5);
+    adoptor-> TREE_ADD_CHILD (2000, "2000");
+    adoptor-> TREE_PEEK_SET (5);
+    adoptor-> TREE_REMOVE;
+
+    adoptor-> TREE_PEEK_SET_ROOT;
+    while (!adoptor-> TREE_PEEK_IS_END) {
+        auto node = adoptor-> TREE_PEEK_NODE;
+        if (node != NULL && node-> data != std::to_string (node-> id))
+            return Quality::Test::FAIL;
+        adoptor-> TREE_PEEK_SET_NEXT;
+    }
+
+    TREE_CLOSE (26);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (26, "child vector spill over from inline storage") {
+    auto myTree = TREE_INIT (27, int);
+
+    /*                                  {1, 10}
+     *                                  |
+     *          -----------------------------------------------------------------
+     *          |           |           |           |           ...             |
+     *          {2, 20}     {3, 30}     {4, 40}     {5, 50}                     {11, 110}
+     *                                  |
+     *                      -------------------------------
+     *                      |           |           ...   |
+     *                      {12, 120}   {13, 130}         {17, 170}
+    */
+    myTree-> TREE_ADD_ROOT (1, 10);
+    myTree-> TREE_PEEK_SET (1);
+    for (int i = 2; i <= 11; i++)
+        myTree-> TREE_ADD_CHILD (i, i * 10);
+
+    myTree-> TREE_PEEK_SET (4);
+    for (int i = 12; i <= 17; i++)
+        myTree-> TREE_ADD_CHILD (i, i * 10);
+
+    // children of {4, 40} take its place in the child vector of {1, 10}
+    myTree-> TREE_PEEK_SET (4);
+    myTree-> TREE_REMOVE_NODE;
+
+    std::vector <size_t> output = { 2, 3, 12, 13, 14, 15, 16, 17, 5, 6, 7, 8, 9, 10, 11 };
+    myTree-> TREE_PEEK_SET (1);
+    if (myTree-> TREE_PEEK_CHILD_COUNT != output.size())
+        return Quality::Test::FAIL;
+
+    size_t idx = 0;
+    for (auto const& child : myTree-> TREE_PEEK_NODE-> child) {
+        if (child-> id != output[idx++] || child-> parent-> id != 1)
+            return Quality::Test::FAIL;
+    }
+
+    // swap nodes with spilled over and inline child vectors
+    myTree-> TREE_PEEK_SET (12);
+    myTree-> TREE_ADD_CHILD (18, 180);
+    myTree-> TREE_SWAP (1, 12);
+
+    myTree-> TREE_PEEK_SET (12);
+    if (myTree-> TREE_PEEK_CHILD_COUNT != output.size() || myTree-> TREE_PEEK_NODE-> child[2]-> id != 1 ||
+        myTree-> TREE_PEEK_NODE-> parent != NULL)
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_PEEK_SET (1);
+    if (myTree-> TREE_PEEK_CHILD_COUNT != 1 || myTree-> TREE_PEEK_NODE-> child[0]-> id != 18)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (27);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (27, "frozen tree") {
+    auto myTree = TREE_INIT (28, int);
+    std::pair <size_t, int> input[] = { { 1, 10 }, 
+                                        { 2, 20 }, { 3, 30 }, { 4, 40 },
+                                        { 5, 50 }, { 6, 60 },             { 7, 70 },
+                                        { 8, 80 } };
+
+    // frozen empty tree
+    if (myTree-> TREE_FREEZE.getSize() != 0 || myTree-> TREE_FREEZE.getCursor().peekIsEnd() != true)
+        return Quality::Test::FAIL;
+
+    // create tree
+    myTree-> TREE_ADD_ROOT (input[0].first, input[0].second);
+    myTree-> TREE_PEEK_SET (1);
+    myTree-> TREE_ADD_CHILD (input[1].first, input[1].second);
+    myTree-> TREE_ADD_NULL_CHILD;
+    myTree-> TREE_ADD_CHILD (input[2].first, input[2].second);
+    myTree-> TREE_ADD_CHILD (input[3].first, input[3].second);
+
+    myTree-> TREE_PEEK_SET (2);
+    myTree-> TREE_ADD_CHILD (input[4].first, input[4].second);
+    myTree-> TREE_ADD_CHILD (input[5].first, input[5].second);
+    myTree-> TREE_PEEK_SET (4);
+    myTree-> TREE_ADD_CHILD (input[6].first, input[6].second);
+    myTree-> TREE_PEEK_SET (5);
+    myTree-> TREE_ADD_CHILD (input[7].first, input[7].second);
+
+    /*                                  {1, 10}
+     *                                  |
+     *                  -------------------------------------------------
+     *                  |               |               |               |
+     *                  {2, 20}         {NULL}          {3, 30}         {4, 40}
+     *                  |                                               |
+     *          -----------------                                       {7, 70}
+     *          |               |
+     *          {5, 50}         {6, 60}
+     *          |
+     *          {8, 80}
+    */
+    auto myFrozen = myTree-> TREE_FREEZE;
+    // the frozen tree is not affected by updates to the tree
+    myTree-> TREE_PEEK_SET (2);
+    myTree-> TREE_REMOVE;
+
+    size_t preorder[]       = { 1, 2, 5, 8, 6, 3, 4, 7 };
+    uint32_t levels[]       = { 1, 2, 3, 4, 3, 2, 2, 3 };
+    uint32_t subtreeEnds[]  = { 8, 5, 4, 4, 5, 6, 8, 8 };
+    if (myFrozen.getSize() != 8)
+        return Quality::Test::FAIL;
+
+    for (uint32_t position = 0; position < 8; position++) {
+        if (myFrozen.getId (position)           != preorder[position]                           ||
+            myFrozen.getData (position)         != static_cast <int> (preorder[position] * 10)  ||
+            myFrozen.getLevel (position)        != levels[position]                             ||
+            myFrozen.getSubtreeEnd (position)   != subtreeEnds[position]                        ||
+            myFrozen.find (preorder[position])  != position)
+            return Quality::Test::FAIL;
+    }
+
+    if (myFrozen.find (9) != TREE_FROZEN_NONE || myFrozen.getParent (0) != TREE_FROZEN_NONE)
+        return Quality::Test::FAIL;
+
+    // subtree as a contiguous range
+    auto subTree = myFrozen.getSubtree (myFrozen.find (2));
+    if (std::accumulate (subTree.begin(), subTree.end(), 0) != 20 + 50 + 80 + 60)
+        return Quality::Test::FAIL;
+
+    if (myFrozen.isAncestor (myFrozen.find (1), myFrozen.find (8))   != true  ||
+        myFrozen.isAncestor (myFrozen.find (2), myFrozen.find (8))   != true  ||
+        myFrozen.isAncestor (myFrozen.find (8), myFrozen.find (8))   != true  ||
+        myFrozen.isAncestor (myFrozen.find (2), myFrozen.find (3))   != false ||
+        myFrozen.isAncestor (myFrozen.find (8), myFrozen.find (5))   != false)
+        return Quality::Test::FAIL;
+
+    // cursor, children of the root
+    std::vector <size_t> childIds;
+    auto myCursor = myFrozen.getCursor();
+    myCursor.peekSetChild();
+    while (!myCursor.peekIsEnd()) {
+        childIds.push_back (myFrozen.getId (myCursor.peekPosition()));
+        myCursor.peekSetNextSibling();
+    }
+    if (childIds != std::vector <size_t> { 2, 3, 4 })
+        return Quality::Test::FAIL;
+
+    myCursor.peekSet (8);
+    myCursor.peekSetParent();
+    myCursor.peekSetParent();
+    if (myFrozen.getId (myCursor.peekPosition()) != 2)
+        return Quality::Test::FAIL;
+
+    myCursor.peekSet (7);
+    myCursor.peekSetNext();
+    if (myCursor.peekIsEnd() != true)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (28);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (28, "parallel fold and visit") {
+    auto myTree = TREE_INIT (29, long);
+    std::mt19937 generator (28);
+    size_t numNodes = 200000;
+
+    // random tree, every node gets a random parent from the nodes added before it
+    myTree-> TREE_ADD_ROOT (0, 0);
+    for (size_t id = 1; id < numNodes; id++) {
+        myTree-> TREE_PEEK_SET (generator() % id);
+        myTree-> TREE_ADD_CHILD (id, static_cast <long> (id));
+    }
+
+    auto sumLambda = [](long* data, std::span <const long> childResults) {
+        return std::accumulate (childResults.begin(), childResults.end(), *data);
+    };
+
+    long output = static_cast <long> (numNodes * (numNodes - 1) / 2);
+    if (myTree-> TREE_FOLD_PARALLEL (long, 1, sumLambda) != output ||
+        myTree-> TREE_FOLD_PARALLEL (long, 4, sumLambda) != output)
+        return Quality::Test::FAIL;
+
+    // per subtree rollup stored in the nodes, every node is set to 1 first so that the rollup is the subtree size
+    myTree-> TREE_VISIT_PARALLEL (4, [](long* data) { *data = 1; });
+    long rootResult = myTree-> TREE_FOLD_PARALLEL (long, 4, [](long* data, std::span <const long> childResults) {
+        *data = std::accumulate (childResults.begin(), childResults.end(), *data);
+        return *data;
+    });
+
+    if (rootResult != static_cast <long> (numNodes))
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_PEEK_SET_ROOT;
+    while (!myTree-> TREE_PEEK_IS_END) {
+        auto node = myTree-> TREE_PEEK_NODE;
+        if (node != NULL && node-> data != static_cast <long> (node-> numDescendants + 1))
+            return Quality::Test::FAIL;
+        myTree-> TREE_PEEK_SET_NEXT;
+    }
+
+    TREE_CLOSE (29);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (29, "batch update of descendant counts") {
+    auto eagerTree = TREE_INIT (30, int);
+    auto batchTree = TREE_INIT (31, int);
+    size_t numNodes = 20000;
+    std::vector <size_t> sizes;
+
+    // same updates on both trees, one with eager descendant counts and the other one in a batch
+    batchTree-> TREE_BATCH_BEGIN;
+    for (auto myTree : { eagerTree, batchTree }) {
+        std::mt19937 generator (29);
+        myTree-> TREE_ADD_ROOT (0, 0);
+
+        for (size_t id = 1; id < numNodes; id++) {
+            // mostly deep chains
+            myTree-> TREE_PEEK_SET ((generator() % 8 == 0) ? generator() % id : id - 1);
+            myTree-> TREE_ADD_CHILD (id, 0);
+
+            if (id % 1000 == 0) {
+                myTree-> TREE_PEEK_SET (id - 500);
+                myTree-> TREE_REMOVE_NODE;
+
+                myTree-> TREE_PEEK_SET (id - 200);
+                auto adoptedNode = myTree-> TREE_ADOPT.first;
+                // the new parent could be in the adopted node/tree, append to root instead
+                myTree-> TREE_PEEK_SET (id / 2);
+                if (myTree-> TREE_APPEND (adoptedNode) == false) {
+                    myTree-> TREE_PEEK_SET_ROOT;
+                    myTree-> TREE_APPEND (adoptedNode);
+                }
+
+                myTree-> TREE_PEEK_SET (id - 100);
+                myTree-> TREE_REMOVE;
+                // size is available mid batch
+                if (myTree == eagerTree)
+                    sizes.push_back (myTree-> TREE_SIZE);
+                else if (myTree-> TREE_SIZE != sizes[id / 1000 - 1])
+                    return Quality::Test::FAIL;
+            }
+        }
+    }
+    batchTree-> TREE_BATCH_COMMIT;
+
+    if (batchTree-> TREE_SIZE != eagerTree-> TREE_SIZE)
+        return Quality::Test::FAIL;
+
+    eagerTree-> TREE_PEEK_SET_ROOT;
+    batchTree-> TREE_PEEK_SET_ROOT;
+    while (!eagerTree-> TREE_PEEK_IS_END) {
+        auto eagerNode = eagerTree-> TREE_PEEK_NODE;
+        auto batchNode = batchTree-> TREE_PEEK_NODE;
+
+        if ((eagerNode == NULL) != (batchNode == NULL))
+            return Quality::Test::FAIL;
+
+        if (eagerNode != NULL && (eagerNode-> id != batchNode-> id || 
+                                  eagerNode-> numDescendants != batchNode-> numDescendants))
+            return Quality::Test::FAIL;
+
+        eagerTree-> TREE_PEEK_SET_NEXT;
+        batchTree-> TREE_PEEK_SET_NEXT;
+    }
+
+    // back to eager updates after commit
+    batchTree-> TREE_PEEK_SET_ROOT;
+    batchTree-> TREE_ADD_CHILD (numNodes, 0);
+    if (batchTree-> TREE_PEEK_NODE-> numDescendants + 1 != eagerTree-> TREE_SIZE + 1)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (30);
+    TREE_CLOSE (31);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (30, "lowest common ancestor") {
+    auto myTree = TREE_INIT (32, int);
+    std::mt19937 generator (30);
+    size_t numNodes = 2000;
+
+    myTree-> TREE_ADD_ROOT (0, 0);
+    for (size_t id = 1; id < numNodes; id++) {
+        myTree-> TREE_PEEK_SET (generator() % id);
+        myTree-> TREE_ADD_CHILD (id, static_cast <int> (id));
+    }
+
+    // walk up the parent pointers and compare against the LCA index
+    auto verifyLCA = [&](size_t idA, size_t idB) {
+        myTree-> TREE_PEEK_SET (idA);
+        auto nodeA = myTree-> TREE_PEEK_NODE;
+        myTree-> TREE_PEEK_SET (idB);
+        auto nodeB = myTree-> TREE_PEEK_NODE;
+
+        auto lcaNode = myTree-> TREE_LCA (idA, idB);
+        if (nodeA == NULL || nodeB == NULL)
+            return lcaNode == NULL && myTree-> TREE_IS_ANCESTOR (idA, idB) == false;
+
+        std::unordered_set <size_t> ancestorsA;
+        for (auto node = nodeA; node != NULL; node = node-> parent)
+            ancestorsA.insert (node-> id);
+
+        auto node = nodeB;
+        while (ancestorsA.find (node-> id) == ancestorsA.end())
+            node = node-> parent;
+
+        return lcaNode == node && myTree-> TREE_IS_ANCESTOR (idA, idB) == (node == nodeA) &&
+                                  myTree-> TREE_IS_ANCESTOR (idB, idA) == (node == nodeB);
+    };
+
+    for (size_t i = 0; i < 5000; i++) {
+        if (!verifyLCA (generator() % numNodes, generator() % numNodes))
+            return Quality::Test::FAIL;
+    }
+    if (!verifyLCA (7, 7) || !verifyLCA (0, 7) || !verifyLCA (7, numNodes))
+        return Quality::Test::FAIL;
+
+    // index is rebuilt after every update
+    for (size_t i = 0; i < 20; i++) {
+        size_t idA = generator() % numNodes;
+        size_t idB = generator() % numNodes;
+
+        switch (i % 3) {
+            case 0:
+                myTree-> TREE_PEEK_SET (idA);
+                myTree-> TREE_ADD_CHILD (numNodes + i, 0);
+                break;
+            case 1:
+                myTree-> TREE_SWAP (idA, idB);
+                break;
+            case 2:
+                myTree-> TREE_PEEK_SET (idA);
+                if (myTree-> TREE_PEEK_NODE != NULL && myTree-> TREE_PEEK_NODE-> parent != NULL)
+                    myTree-> TREE_REMOVE;
+                break;
+        }
+
+        for (size_t j = 0; j < 200; j++) {
+            if (!verifyLCA (generator() % (numNodes + i + 1), generator() % (numNodes + i + 1)))
+                return Quality::Test::FAIL;
+        }
+    }
+
+    TREE_CLOSE (32);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (31, "tails and heights across updates") {
+    auto myTree = TREE_INIT (33, int);
+    std::mt19937 generator (31);
+    size_t numNodes = 500;
+
+    // batch build, heights are filled in on commit
+    myTree-> TREE_BATCH_BEGIN;
+    myTree-> TREE_ADD_ROOT (0, 0);
+    for (size_t id = 1; id < numNodes; id++) {
+        myTree-> TREE_PEEK_SET (generator() % id);
+        myTree-> TREE_ADD_CHILD (id, static_cast <int> (id));
+    }
+    myTree-> TREE_BATCH_COMMIT;
+
+    // every node's height is one more than its tallest child, and tails are the nodes without children
+    auto verifyTails = [&](void) {
+        std::vector <size_t> tailIds;
+        myTree-> TREE_PEEK_SET_ROOT;
+        while (!myTree-> TREE_PEEK_IS_END) {
+            auto node = myTree-> TREE_PEEK_NODE;
+            if (node != NULL) {
+                size_t height = 0;
+                for (auto const& child : node-> child) {
+                    if (child != NULL)
+                        height = std::max (height, child-> height + 1);
+                }
+
+                if (node-> height != height)
+                    return false;
+                if (height == 0)
+                    tailIds.push_back (node-> id);
+            }
+            myTree-> TREE_PEEK_SET_NEXT;
+        }
+        // ask twice, the second call is served from the saved tails
+        return myTree-> TREE_TAILS == tailIds && myTree-> TREE_TAILS == tailIds;
+    };
+
+    if (!verifyTails())
+        return Quality::Test::FAIL;
+
+    for (size_t i = 0; i < 300; i++) {
+        size_t idA = generator() % numNodes;
+        size_t idB = generator() % numNodes;
+        myTree-> TREE_PEEK_SET (idA);
+        if (myTree-> TREE_PEEK_NODE == NULL)
+            continue;
+
+        switch (i % 5) {
+            case 0:
+                myTree-> TREE_ADD_CHILD (numNodes + i, 0);
+                break;
+            case 1:
+                myTree-> TREE_REMOVE_NODE;
+                break;
+            case 2:
+                if (myTree-> TREE_PEEK_NODE-> parent != NULL)
+                    myTree-> TREE_REMOVE;
+                break;
+            case 3:
+                myTree-> TREE_SWAP (idA, idB);
+                break;
+            case 4:
+                myTree-> TREE_ADD_PARENT (numNodes + i, 0);
+                break;
+        }
+
+        if (!verifyTails())
+            return Quality::Test::FAIL;
+    }
+
+    TREE_CLOSE (33);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (32, "bulk build") {
+    auto myTree = TREE_INIT (34, int);
+    std::vector <std::tuple <size_t, size_t, int>> input = { { 4, 2, 40 }, 
+                                                             { 2, 1, 20 }, 
+                                                             { 5, 3, 50 }, 
+                                                             { 1, TREE_BUILD_NO_PARENT, 10 }, 
+                                                             { 3, 1, 30 }, 
+                                                             { 6, 2, 60 } };
+
+    myTree-> TREE_IMPORT (myTree-> TREE_BUILD (input));
+    /*                                  {1, 10}
+     *                                  |
+     *                          -----------------
+     *                          |               |
+     *                          {2, 20}         {3, 30}
+     *                          |               |
+     *                  -----------------       {5, 50}
+     *                  |               |
+     *                  {4, 40}         {6, 60}
+    */
+    size_t numNodes = 6;
+    size_t depth = 3;
+    size_t levels[] =               { 1, 2, 2, 3, 3, 3 };
+    size_t numChildren[] =          { 2, 2, 1, 0, 0, 0 };
+    size_t ids[] =                  { 1, 2, 3, 4, 6, 5 };
+    size_t numDescendants[] =       { 5, 2, 1, 0, 0, 0 };
+    size_t parents[] =              { 0, 1, 1, 2, 2, 3 };
+    size_t nullPos[] =              { 0, 0, 0, 0, 0, 0 };
+
+    if (verifyTree <int> (myTree, 
+        {
+            numNodes,
+            depth,
+            levels,
+            numChildren,
+            ids,
+            numDescendants,
+            parents,
+            nullPos
+        }) == false)
+        return Quality::Test::FAIL;
+
+    // the built tree is updated like any other tree
+    myTree-> TREE_PEEK_SET (5);
+    myTree-> TREE_ADD_CHILD (7, 70);
+    if (myTree-> TREE_SIZE != 7 || myTree-> TREE_DEPTH != 4 || myTree-> TREE_PATH (7, 4).size() != 6)
+        return Quality::Test::FAIL;
+
+    // invalid inputs
+    std::vector <std::tuple <size_t, size_t, int>> noRoot       = { { 1, 2, 0 }, { 2, 1, 0 } };
+    std::vector <std::tuple <size_t, size_t, int>> twoRoots     = { { 1, TREE_BUILD_NO_PARENT, 0 }, 
+                                                                    { 2, TREE_BUILD_NO_PARENT, 0 } };
+    std::vector <std::tuple <size_t, size_t, int>> cycle        = { { 1, TREE_BUILD_NO_PARENT, 0 }, 
+                                                                    { 2, 3, 0 }, { 3, 2, 0 } };
+    std::vector <std::tuple <size_t, size_t, int>> noParent     = { { 1, TREE_BUILD_NO_PARENT, 0 }, { 2, 9, 0 } };
+    std::vector <std::tuple <size_t, size_t, int>> repeatedId   = { { 1, TREE_BUILD_NO_PARENT, 0 }, 
+                                                                    { 2, 1, 0 }, { 2, 1, 0 } };
+    if (myTree-> TREE_BUILD (noRoot)                                        != NULL ||
+        myTree-> TREE_BUILD (twoRoots)                                      != NULL ||
+        myTree-> TREE_BUILD (cycle)                                         != NULL ||
+        myTree-> TREE_BUILD (noParent)                                      != NULL ||
+        myTree-> TREE_BUILD (repeatedId)                                    != NULL ||
+        myTree-> TREE_BUILD_FROM_PARENTS (std::vector <size_t> { 0 }, 
+                                          std::vector <int> { 0 })          != NULL ||
+        myTree-> TREE_BUILD_FROM_PARENTS (std::vector <size_t> { }, 
+                                          std::vector <int> { })            != NULL)
+        return Quality::Test::FAIL;
+
+    // parent index array against the same tree built one node at a time
+    auto refTree = TREE_INIT (35, int);
+    std::mt19937 generator (32);
+    numNodes = 100000;
+
+    std::vector <size_t> parentIndices (numNodes, TREE_BUILD_NO_PARENT);
+    std::vector <int> data (numNodes);
+    refTree-> TREE_ADD_ROOT (0, 0);
+    for (size_t i = 1; i < numNodes; i++) {
+        parentIndices[i] = generator() % i;
+        data[i] = static_cast <int> (i);
+
+        refTree-> TREE_PEEK_SET (parentIndices[i]);
+        refTree-> TREE_ADD_CHILD (i, data[i]);
+    }
+
+    myTree-> TREE_IMPORT (myTree-> TREE_BUILD_FROM_PARENTS (parentIndices, data));
+    if (myTree-> TREE_SIZE != refTree-> TREE_SIZE || myTree-> TREE_DEPTH != refTree-> TREE_DEPTH)
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_PEEK_SET_ROOT;
+    refTree-> TREE_PEEK_SET_ROOT;
+    while (!refTree-> TREE_PEEK_IS_END) {
+        auto node    = myTree-> TREE_PEEK_NODE;
+        auto refNode = refTree-> TREE_PEEK_NODE;
+
+        if (node-> id             != refNode-> id             || node-> data   != refNode-> data   ||
+            node-> numDescendants != refNode-> numDescendants || node-> height != refNode-> height ||
+            myTree-> TREE_PEEK_LEVEL != refTree-> TREE_PEEK_LEVEL)
+            return Quality::Test::FAIL;
+
+        myTree-> TREE_PEEK_SET_NEXT;
+        refTree-> TREE_PEEK_SET_NEXT;
+    }
+
+    if (!myTree-> TREE_PEEK_IS_END)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (34);
+    TREE_CLOSE (35);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (33, "levels after moving nodes") {
+    auto myTree = TREE_INIT (36, int);
+
+    // { id, expected level } pairs, the level is checked against the index and against a walk up to the root
+    auto checkLevels = [myTree](std::vector <std::pair <size_t, size_t>> expected, size_t depth) {
+        for (auto const& [id, level] : expected) {
+            myTree-> TREE_PEEK_SET (id);
+            auto node = myTree-> TREE_PEEK_NODE;
+            if (node == NULL || myTree-> TREE_PEEK_LEVEL != level)
+                return false;
+
+            size_t walkLevel = 0;
+            for (; node != NULL; node = node-> parent)
+                walkLevel++;
+            if (walkLevel != level)
+                return false;
+        }
+        return myTree-> TREE_DEPTH == depth;
+    };
+
+    /*          0
+     *        /   \
+     *       1     2
+     *      / \
+     *     3  NULL
+     *     |
+     *     4
+    */
+    myTree-> TREE_ADD_ROOT (0, 0);
+    myTree-> TREE_PEEK_SET_ROOT;
+    myTree-> TREE_ADD_CHILD (1, 1);
+    myTree-> TREE_ADD_CHILD (2, 2);
+    myTree-> TREE_PEEK_SET (1);
+    myTree-> TREE_ADD_CHILD (3, 3);
+    myTree-> TREE_ADD_NULL_CHILD;
+    myTree-> TREE_PEEK_SET (3);
+    myTree-> TREE_ADD_CHILD (4, 4);
+    if (!checkLevels ({ { 0, 1 }, { 1, 2 }, { 2, 2 }, { 3, 3 }, { 4, 4 } }, 4))
+        return Quality::Test::FAIL;
+
+    // every node moves down by a level, twice
+    myTree-> TREE_ADD_ROOT (10, 10);
+    myTree-> TREE_ADD_ROOT (11, 11);
+    if (!checkLevels ({ { 11, 1 }, { 10, 2 }, { 0, 3 }, { 1, 4 }, { 2, 4 }, { 3, 5 }, { 4, 6 } }, 6))
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_PEEK_SET (0);
+    if (myTree-> TREE_LCA (4, 2) != myTree-> TREE_PEEK_NODE)
+        return Quality::Test::FAIL;
+
+    // 1 -> 20 -> 3 -> 4
+    myTree-> TREE_PEEK_SET (3);
+    myTree-> TREE_ADD_PARENT (20, 20);
+    if (!checkLevels ({ { 1, 4 }, { 20, 5 }, { 3, 6 }, { 4, 7 } }, 7))
+        return Quality::Test::FAIL;
+
+    // 20 and the NULL child of 1 become children of 0
+    myTree-> TREE_PEEK_SET (1);
+    myTree-> TREE_REMOVE_NODE;
+    if (!checkLevels ({ { 0, 3 }, { 20, 4 }, { 2, 4 }, { 3, 5 }, { 4, 6 } }, 6))
+        return Quality::Test::FAIL;
+
+    myTree-> TREE_PEEK_SET (20);
+    myTree-> TREE_REMOVE_NODE;
+    if (!checkLevels ({ { 3, 4 }, { 4, 5 } }, 5) || myTree-> TREE_SIZE != 6)
+        return Quality::Test::FAIL;
+
+    TREE_CLOSE (36);
+    return Quality::Test::PASS;
+}
+
 int main (void) {
     LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/Tree/");
     LIB_TEST_RUN_ALL;
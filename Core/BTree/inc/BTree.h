@@ -53,13 +53,22 @@
 #define BTREE_SWAP(idA, idB)                    swap (idA, idB)
 #define BTREE_IMPORT(node)                      importTree (node)
 #define BTREE_RESET                             importTree (NULL)
+#define BTREE_BATCH_BEGIN                       beginBatch()
+#define BTREE_BATCH_COMMIT                      commitBatch()
 
 // 'utils' methods
 #define BTREE_SIZE                              getSize()
 #define BTREE_DEPTH                             getDepth()
 #define BTREE_DEEPEST                           getDeepest()
 #define BTREE_PATH(idA, idB)                    getPath (idA, idB)
+#define BTREE_LCA(idA, idB)                     getLCA (idA, idB)
+#define BTREE_IS_ANCESTOR(idA, idB)             isAncestor (idA, idB)
 #define BTREE_TAILS                             getTails()
+#define BTREE_FREEZE                            freeze()
+#define BTREE_FOLD_PARALLEL(resultType,                                                                         \
+                            numThreads, lambda) foldParallel <resultType> (numThreads, lambda)
+#define BTREE_VISIT_PARALLEL(numThreads,                                                                        \
+                             lambda)            visitParallel (numThreads, lambda)
 #define BTREE_DUMP                              dump (std::cout)
 #define BTREE_DUMP_CUSTOM(lambda)               dump (std::cout, lambda)                                  
 #endif  // BTREE_H
\ No newline at end of file
@@ -24,8 +24,9 @@ namespace Memory {
         RIGHT_CHILD = 1
     }e_child;
 
+    // a binary tree node always has exactly 2 child slots (left and right), so both are stored inline in the node
     template <typename T>
-    class BTree : public Tree <T> {
+    class BTree : public Tree <T, 2> {
         private:
             /* In a template that we write, there are two kinds of names (identifiers) that could be used - dependant names
              * and non- dependant names. A dependant name is a name that depends on a template parameter; a non- dependant 
@@ -47,13 +48,13 @@ namespace Memory {
              * By default, a dependant name is assumed to be the name of a non-type. The typename keyword before a 
              * dependant name disambiguates it to be the name of a type.
             */
-            typedef typename Tree <T>::s_Node m_Node;
+            typedef typename Tree <T, 2>::s_Node m_Node;
 
         public:
-            BTree (size_t instanceId) : Tree <T> (instanceId) { }
+            BTree (size_t instanceId) : Tree <T, 2> (instanceId) { }
 
             m_Node* peekChild (e_child child) {
-                m_Node* parentNode = Tree <T>::peekNode();
+                m_Node* parentNode = Tree <T, 2>::peekNode();
                 // invalid peek id
                 if (parentNode == NULL)
                     return NULL;
@@ -62,43 +63,26 @@ namespace Memory {
             }
           
             bool addLeft (size_t id, const T& data) {
-                Tree <T>::savePeek();
-                m_Node* parenttNode = Tree <T>::peekNode();
+                Tree <T, 2>::savePeek();
+                m_Node* parenttNode = Tree <T, 2>::peekNode();
                 // invalid peek id
                 if (parenttNode == NULL)
                     return false;
 
-                /* (1) initially, both left and right child are set to NULL
-                 *     current node ---- LEFT CHILD -----> [NULL] 
+                /* initially, both left and right child are set to NULL, the new node takes the place of the NULL left child
+                 *     current node ---- LEFT CHILD -----> [NULL] -----> [NODE]
                  *                  |
                  *                  ---- RIGHT CHILD ----> [NODE/NULL]
-                 *
-                 * (2) addChild() adds the non NULL child at the end of the vector
-                 *     current node ---- LEFT CHILD -----> [NULL]
-                 *                  |
-                 *                  ---- RIGHT CHILD ----> [NODE/NULL]
-                 *                  |
-                 *                  ---- THIRD CHILD ----> [NODE]
-                 * 
-                 * (3) move the third child to the first position (left child)
-                 *     current node ---- THIRD CHILD ----> [NODE] -----> becomes new left child
-                 *                  |
-                 *                  ---- RIGHT CHILD ----> [NODE/NULL]
-                 *                  |
-                 *                  ---- LEFT CHILD -----> [NULL] -----> pop back()
                 */
                 if (peekChild (LEFT_CHILD) == NULL) {
-                    Tree <T>::addChild (id, data);
-
-                    std::reverse (parenttNode-> child.begin(), parenttNode-> child.end());
-                    parenttNode-> child.pop_back();
+                    Tree <T, 2>::addChildAt (LEFT_CHILD, id, data);
 
                     // set left and right child of new node to NULL
-                    Tree <T>::peekSet (id);
-                    Tree <T>::addNullChild();
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSet (id);
+                    Tree <T, 2>::addNullChild();
+                    Tree <T, 2>::addNullChild();
 
-                    Tree <T>::restorePeek();
+                    Tree <T, 2>::restorePeek();
                     return true;                    
                 }
                 else
@@ -106,37 +90,26 @@ namespace Memory {
             }
 
             bool addRight (size_t id, const T& data) {
-                Tree <T>::savePeek();
-                m_Node* parenttNode = Tree <T>::peekNode();
+                Tree <T, 2>::savePeek();
+                m_Node* parenttNode = Tree <T, 2>::peekNode();
                 // invalid peek id
                 if (parenttNode == NULL)
                     return false;
 
-                /* (1) initially, both left and right child are set to NULL
-                 *     current node ---- LEFT CHILD -----> [NODE/NULL] 
-                 *                  |
-                 *                  ---- RIGHT CHILD ----> [NULL]
-                 * 
-                 * (2) pop back from child vector
+                /* initially, both left and right child are set to NULL, the new node takes the place of the NULL right child
                  *     current node ---- LEFT CHILD -----> [NODE/NULL]
                  *                  |
-                 *                  ---- RIGHT CHILD ----> []
-                 * 
-                 * (3) use addChild() to add the right child
-                 *     current node ---- LEFT CHILD -----> [NODE/NULL]
-                 *                  |
-                 *                  ---- RIGHT CHILD ----> [NODE]
+                 *                  ---- RIGHT CHILD ----> [NULL] -----> [NODE]
                 */
                 if (peekChild (RIGHT_CHILD) == NULL) {
-                    parenttNode-> child.pop_back();
-                    Tree <T>::addChild (id, data);
+                    Tree <T, 2>::addChildAt (RIGHT_CHILD, id, data);
 
                     // set left and right child of new node to NULL
-                    Tree <T>::peekSet (id);
-                    Tree <T>::addNullChild();
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSet (id);
+                    Tree <T, 2>::addNullChild();
+                    Tree <T, 2>::addNullChild();
 
-                    Tree <T>::restorePeek();
+                    Tree <T, 2>::restorePeek();
                     return true;
                 }
                 else
@@ -149,7 +122,7 @@ namespace Memory {
              * the nodes should be added from the left)
             */
             bool addTail (size_t id, const T& data) {
-                m_Node* parentNode = Tree <T>::peekNode();
+                m_Node* parentNode = Tree <T, 2>::peekNode();
                 // invalid peek id
                 if (parentNode == NULL)
                     return false;
@@ -162,7 +135,7 @@ namespace Memory {
                     pendingQ.pop();
                     
                     // set peek to current node
-                    Tree <T>::peekSet (currentNode-> id);
+                    Tree <T, 2>::peekSet (currentNode-> id);
 
                     if (addLeft (id, data) == false)
                         pendingQ.push (peekChild (LEFT_CHILD));
@@ -179,7 +152,7 @@ namespace Memory {
                  * restore methods since the calls to addLeft() or addRight() would overwrite the saved peek with the 
                  * current node (we should be careful when nesting methods with save-restore statements)
                 */
-                Tree <T>::peekSet (parentNode-> id);
+                Tree <T, 2>::peekSet (parentNode-> id);
                 return true;
             }
 
@@ -187,9 +160,9 @@ namespace Memory {
              * { node, level }  -> at new parent node, if valid id
             */
             bool addParent (size_t id, const T& data) {
-                if (Tree <T>::addParent (id, data) == true) {
+                if (Tree <T, 2>::addParent (id, data) == true) {
                     // peek is at the newly added parent, you can add NULL child now
-                    Tree <T>::addNullChild();                   
+                    Tree <T, 2>::addNullChild();                   
                     return true;
                 }
                 
@@ -214,7 +187,7 @@ namespace Memory {
             */
             std::pair <m_Node*, bool> removeNode (bool adopt = false) {
                 // (1)
-                m_Node* nodeToDelete = Tree <T>::peekNode();
+                m_Node* nodeToDelete = Tree <T, 2>::peekNode();
                 
                 // (2)
                 m_Node* deepestNode  = getDeepest();
@@ -224,18 +197,18 @@ namespace Memory {
                     return { NULL, false };
 
                 // (3)
-                Tree <T>::swap (nodeToDelete-> id, deepestNode-> id);
+                Tree <T, 2>::swap (nodeToDelete-> id, deepestNode-> id);
 
                 // (4) 
                 m_Node* parentNode = nodeToDelete-> parent;
                 if (parentNode != NULL) {
-                    Tree <T>::peekSet (parentNode-> id);
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSet (parentNode-> id);
+                    Tree <T, 2>::addNullChild();
                 }
 
                 // (5) here we use the remove() method to grab the node and it's two NULL children
-                Tree <T>::peekSet (nodeToDelete-> id);
-                return Tree <T>::remove (adopt);
+                Tree <T, 2>::peekSet (nodeToDelete-> id);
+                return Tree <T, 2>::remove (adopt);
             }
 
             /* returns either of the 3 pairs
@@ -247,7 +220,7 @@ namespace Memory {
              * { NULL, 0 }      -> reset peek, if valid id
             */
             std::pair <m_Node*, bool> remove (bool adopt = false) {
-                m_Node* nodeToDelete = Tree <T>::peekNode();
+                m_Node* nodeToDelete = Tree <T, 2>::peekNode();
                 // invalid peek id
                 if (nodeToDelete == NULL)
                     return { NULL, false };
@@ -255,16 +228,16 @@ namespace Memory {
                 // add NULL child in place of deleted node
                 m_Node* parentNode = nodeToDelete-> parent;
                 if (parentNode != NULL) {
-                    Tree <T>::peekSet (parentNode-> id);
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSet (parentNode-> id);
+                    Tree <T, 2>::addNullChild();
                 }
 
-                Tree <T>::peekSet (nodeToDelete-> id);
-                return Tree <T>::remove (adopt);
+                Tree <T, 2>::peekSet (nodeToDelete-> id);
+                return Tree <T, 2>::remove (adopt);
             }
 
             void addRoot (size_t id, const T& data) {
-                Tree <T>::savePeek();
+                Tree <T, 2>::savePeek();
                 /* if first node in the tree
                  *                          {root}
                  *                          |
@@ -272,13 +245,13 @@ namespace Memory {
                  *                  |               |
                  *                  {NULL}          {NULL}
                 */
-                if (Tree <T>::m_rootNode == NULL) {
-                    Tree <T>::addRoot (id, data);
+                if (Tree <T, 2>::m_rootNode == NULL) {
+                    Tree <T, 2>::addRoot (id, data);
 
                     // set left and right child to NULL
-                    Tree <T>::peekSetRoot();
-                    Tree <T>::addNullChild();
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSetRoot();
+                    Tree <T, 2>::addNullChild();
+                    Tree <T, 2>::addNullChild();
                 }
 
                 /* if addRoot() is called on an existing tree
@@ -293,30 +266,23 @@ namespace Memory {
                  *          {NULL}          {NULL}
                 */
                 else {
-                    Tree <T>::addRoot (id, data);
+                    Tree <T, 2>::addRoot (id, data);
 
                     // set right child to NULL
-                    Tree <T>::peekSetRoot();
-                    Tree <T>::addNullChild();
+                    Tree <T, 2>::peekSetRoot();
+                    Tree <T, 2>::addNullChild();
                 }
 
-                Tree <T>::restorePeek();
+                Tree <T, 2>::restorePeek();
             }
 
             m_Node* getDeepest (void) {
-                if (Tree <T>::m_rootNode == NULL)
+                if (Tree <T, 2>::m_rootNode == NULL)
                     return NULL;
 
-                // the last element in the tail vector will be the deepest (right most) node
-                else {
-                    Tree <T>::savePeek();
-                    Tree <T>::peekSet (Tree <T>::getTails().back());
-
-                    m_Node* deepestNode = Tree <T>::peekNode();
-
-                    Tree <T>::restorePeek();
-                    return deepestNode;
-                }
+                // the deepest (right most) node, same as the last element in the tail vector
+                else
+                    return Tree <T, 2>::getDeepestNode();
             }
     };
 }   // namespace Memory
@@ -14,6 +14,7 @@
 #include "../inc/BTree.h"
 #include "../../../Common/LibTest/inc/LibTest.h"
 #include "../../../Common/Tree/sample/Test_Helper.h"
+#include <random>
 
 using namespace Collections;
 
@@ -1661,6 +1662,90 @@ LIB_TEST_CASE (13, "add parent") {
     return Quality::Test::PASS;
 }
 
+LIB_TEST_CASE (15, "depth maintained across add tail and remove node") {
+    auto myTree = BTREE_INIT (15, int);
+
+    myTree-> BTREE_ADD_ROOT (1, 10);
+    myTree-> BTREE_PEEK_SET_ROOT;
+    for (size_t i = 2; i <= 64; i++)
+        myTree-> BTREE_ADD_TAIL (i, static_cast <int> (i * 10));
+
+    // 63 nodes fill 6 levels, node 64 starts level 7 and its NULL children are at level 8
+    if (myTree-> BTREE_DEPTH != 8)
+        return Quality::Test::FAIL;
+
+    // remove from the root, deepest node takes its place every time
+    for (size_t numNodes = 64; numNodes > 0; numNodes--) {
+        size_t depth = 0;
+        myTree-> BTREE_PEEK_SET_ROOT;
+        while (!myTree-> BTREE_PEEK_IS_END) {
+            depth = std::max (depth, myTree-> BTREE_PEEK_LEVEL);
+            myTree-> BTREE_PEEK_SET_NEXT;
+        }
+
+        if (myTree-> BTREE_DEPTH != depth || myTree-> BTREE_SIZE != numNodes)
+            return Quality::Test::FAIL;
+
+        myTree-> BTREE_PEEK_SET_ROOT;
+        myTree-> BTREE_REMOVE_NODE;
+    }
+
+    if (myTree-> BTREE_DEPTH != 0)
+        return Quality::Test::FAIL;
+
+    BTREE_CLOSE (15);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (16, "deepest node across add and remove node") {
+    auto myTree = BTREE_INIT (16, int);
+    std::mt19937 generator (16);
+    size_t numNodes = 1000;
+
+    // random shape, every node gets a left or right child at a random NULL slot
+    myTree-> BTREE_ADD_ROOT (0, 0);
+    for (size_t id = 1; id < numNodes; id++) {
+        while (true) {
+            myTree-> BTREE_PEEK_SET (generator() % id);
+            if ((generator() % 2 == 0 && myTree-> BTREE_ADD_LEFT  (id, 0)) ||
+                myTree-> BTREE_ADD_RIGHT (id, 0))
+                break;
+        }
+    }
+
+    for (size_t i = 0; i < numNodes; i++) {
+        // last node in level order
+        auto lastNode = myTree-> BTREE_PEEK_NODE;
+        myTree-> BTREE_PEEK_SET_ROOT;
+        while (!myTree-> BTREE_PEEK_IS_END) {
+            if (myTree-> BTREE_PEEK_NODE != NULL)
+                lastNode = myTree-> BTREE_PEEK_NODE;
+            myTree-> BTREE_PEEK_SET_NEXT;
+        }
+
+        std::vector <size_t> tailIds = myTree-> BTREE_TAILS;
+        if (myTree-> BTREE_DEEPEST != lastNode || tailIds.back() != lastNode-> id)
+            return Quality::Test::FAIL;
+
+        // remove a random node, deepest node takes its place
+        do {
+            myTree-> BTREE_PEEK_SET (generator() % numNodes);
+        } while (myTree-> BTREE_PEEK_NODE == NULL);
+        myTree-> BTREE_REMOVE_NODE;
+
+        if (myTree-> BTREE_SIZE != numNodes - i - 1)
+            return Quality::Test::FAIL;
+        if (myTree-> BTREE_SIZE == 0)
+            break;
+    }
+
+    if (myTree-> BTREE_DEEPEST != NULL)
+        return Quality::Test::FAIL;
+
+    BTREE_CLOSE (16);
+    return Quality::Test::PASS;
+}
+
 int main (void) {
     LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/BTree/");
     LIB_TEST_RUN_ALL;
@@ -0,0 +1,65 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "CacheMgr.h"
+
+// cache manager methods
+#define CACHE_INIT(id,                                                                                          \
+                   policy,                                                                                      \
+                   dataType,                                                                                    \
+                   capacityType,                                                                                \
+                   capacity)                    Memory::cacheMgr.initCache <dataType> (id,                      \
+                                                                                       policy,                  \
+                                                                                       capacityType,            \
+                                                                                       capacity)
+/* thread safe cache, entries are split across numShards shards with a lock each. Lookups of ids in different shards do
+ * not contend with each other. The capacity is split evenly across the shards, so with CAPACITY_BYTES an entry larger
+ * than (capacity / numShards) bytes is rejected by CACHE_PUT_SIZED even though the cache as a whole could hold it
+*/
+#define CACHE_INIT_SHARDED(id,                                                                                  \
+                           policy,                                                                              \
+                           dataType,                                                                            \
+                           capacityType,                                                                        \
+                           capacity,                                                                            \
+                           numShards)           Memory::cacheMgr.initCache <dataType> (id,                      \
+                                                                                       policy,                  \
+                                                                                       capacityType,            \
+                                                                                       capacity,                \
+                                                                                       true,                    \
+                                                                                       numShards)
+#define GET_CACHE(id, dataType)                 dynamic_cast <Memory::Cache <dataType> *>                       \
+                                                (Memory::cacheMgr.getInstance (id))
+#define CACHE_CLOSE(id)                         Memory::cacheMgr.closeInstance (id)
+#define CACHE_CLOSE_ALL                         Memory::cacheMgr.closeAllInstances()
+#define CACHE_MGR_DUMP                          Memory::cacheMgr.dump (std::cout)
+
+// returns true on a hit, and copies the entry's data into data
+#define CACHE_GET(id, data)                     get (id, data)
+#define CACHE_PUT(id, data)                     put (id, data)
+// use with CAPACITY_BYTES, to set the size of the entry
+#define CACHE_PUT_SIZED(id, data, numBytes)     put (id, data, numBytes)
+#define CACHE_REMOVE(id)                        remove (id)
+// lambda is called with (size_t id, T* data) for every evicted entry
+#define CACHE_ON_EVICT(lambda)                  setEvictionCallback (lambda)
+
+// utils
+#define CACHE_STATS                             getStats()
+#define CACHE_USAGE                             getUsage()
+#define CACHE_RESET                             reset()
+#define CACHE_SIZE                              getSize()
+#define CACHE_DUMP                              dump (std::cout)
+#define CACHE_DUMP_CUSTOM(lambda)               dump (std::cout, lambda)
+#endif  // CACHE_H
\ No newline at end of file
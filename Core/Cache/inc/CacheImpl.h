@@ -0,0 +1,467 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CACHE_IMPL_H
+#define CACHE_IMPL_H
+
+#include "../../List/inc/ListImpl.h"
+#include <unordered_map>
+#include <mutex>
+
+namespace Collections {
+namespace Memory {
+    typedef enum {
+        // evict the least recently used entry
+        LRU = 1,
+        // evict the least frequently used entry, ties are broken by recency
+        LFU = 2
+    }e_policy;
+
+    typedef enum {
+        // capacity is the number of entries
+        CAPACITY_ENTRIES = 1,
+        // capacity is the sum of entry sizes (in bytes) passed in with each put
+        CAPACITY_BYTES = 2
+    }e_capacity;
+
+    typedef struct CacheStats {
+        size_t numHits;
+        size_t numMisses;
+        size_t numEvictions;
+    }s_CacheStats;
+
+    /* A cache is a set of shards, each shard is a list holding the entries in eviction order (head is the next entry to
+     * be evicted) along with a hash index from entry id to its node, so that a lookup never has to walk the list. Entries
+     * are assigned to shards by their id. In thread safe mode, each shard has its own lock so that lookups of ids in
+     * different shards do not contend with each other; the capacity is split evenly between the shards
+    */
+    template <typename T>
+    class Cache: public Admin::NonTemplateBase {
+        private:
+            class Shard: public List <T> {
+                private:
+                    typedef typename List <T>::s_Node m_Node;
+
+                    typedef struct Entry {
+                        m_Node* node;
+                        size_t frequency;
+                        // 1 for entry capacity, size in bytes otherwise
+                        size_t cost;
+                    }s_Entry;
+
+                    e_policy m_policy;
+                    e_capacity m_capacityType;
+                    size_t m_capacity;
+                    size_t m_usage;
+
+                    std::unordered_map <size_t, s_Entry> m_index;
+                    /* LFU only, the list is ordered by frequency (lowest at head) and then by recency. This maps each
+                     * frequency to the last node with that frequency, so that a node can be moved to the end of its
+                     * new frequency bucket without walking the list
+                    */
+                    std::unordered_map <size_t, m_Node*> m_bucketTails;
+
+                    std::mutex m_mutex;
+
+                    size_t m_numHits;
+                    size_t m_numMisses;
+                    size_t m_numEvictions;
+
+                    // move an unlinked node back into the list after the NOI (node of interest)
+                    void relinkAfter (m_Node* currentNode, m_Node* node) {
+                        List <T>::unlinkNode (node);
+                        List <T>::linkAfter (currentNode, node);
+                        // unlink doesn't know the node is coming back
+                        List <T>::m_numNodes++;
+                    }
+
+                    // if the node is the last node of its frequency bucket, the previous node takes its place
+                    void detachFromBucket (m_Node* node, size_t frequency) {
+                        auto bucket = m_bucketTails.find (frequency);
+                        if (bucket-> second != node)
+                            return;
+
+                        m_Node* previousNode = node-> previous;
+                        if (previousNode != NULL && m_index.at (previousNode-> id).frequency == frequency)
+                            bucket-> second = previousNode;
+                        // bucket is now empty
+                        else
+                            m_bucketTails.erase (bucket);
+                    }
+
+                    // record an access to the entry
+                    void touch (s_Entry& entry) {
+                        m_Node* node = entry.node;
+                        if (m_policy == LRU) {
+                            if (node != List <T>::m_tailNode)
+                                relinkAfter (List <T>::m_tailNode, node);
+                            return;
+                        }
+
+                        // move to the end of the next frequency bucket, which follows the current one in the list
+                        auto nextBucket = m_bucketTails.find (entry.frequency + 1);
+                        m_Node* targetNode = (nextBucket != m_bucketTails.end()) ? nextBucket-> second :
+                                                                                    m_bucketTails.at (entry.frequency);
+                        detachFromBucket (node, entry.frequency);
+                        // node is already the last node of its bucket and there is no next bucket
+                        if (targetNode != node)
+                            relinkAfter (targetNode, node);
+
+                        entry.frequency++;
+                        m_bucketTails[entry.frequency] = node;
+                    }
+
+                    void link (m_Node* node) {
+                        m_Node* headNode = List <T>::m_headNode;
+                        m_Node* tailNode = List <T>::m_tailNode;
+                        // new entries have the lowest frequency, so they go after the last node with frequency 1
+                        m_Node* previousNode = tailNode;
+                        if (m_policy == LFU) {
+                            auto bucket = m_bucketTails.find (1);
+                            previousNode = (bucket != m_bucketTails.end()) ? bucket-> second : NULL;
+                            m_bucketTails[1] = node;
+                        }
+
+                        if (previousNode != NULL)
+                            List <T>::linkAfter (previousNode, node);
+
+                        else if (headNode != NULL)
+                            List <T>::linkBefore (headNode, node);
+
+                        // if new node is the only node in the list
+                        else {
+                            List <T>::m_headNode = node;
+                            List <T>::m_tailNode = node;
+                        }
+                    }
+
+                    void removeNode (m_Node* node) {
+                        auto entry = m_index.find (node-> id);
+                        if (m_policy == LFU)
+                            detachFromBucket (node, entry-> second.frequency);
+
+                        m_usage -= entry-> second.cost;
+                        m_index.erase (entry);
+
+                        List <T>::unlinkNode (node);
+                        List <T>::destroyNode (node);
+                    }
+
+                    // evict from head until there is room for the given cost, the node to keep is never evicted
+                    void evict (size_t cost, m_Node* keepNode, void (*lambda) (size_t, T*)) {
+                        while (m_usage + cost > m_capacity) {
+                            m_Node* victimNode = List <T>::m_headNode;
+                            if (victimNode == keepNode)
+                                victimNode = victimNode-> next;
+
+                            m_numEvictions++;
+                            if (lambda != NULL)
+                                lambda (victimNode-> id, & (victimNode-> data));
+
+                            removeNode (victimNode);
+                        }
+                    }
+
+                public:
+                    Shard (size_t shardId, e_policy policy, e_capacity capacityType, size_t capacity) : 
+                    List <T> (shardId) {
+                        m_policy = policy;
+                        m_capacityType = capacityType;
+                        m_capacity = capacity;
+                        m_usage = 0;
+
+                        m_numHits = 0;
+                        m_numMisses = 0;
+                        m_numEvictions = 0;
+                    }
+
+                    bool get (size_t id, T& data) {
+                        auto entry = m_index.find (id);
+                        if (entry == m_index.end()) {
+                            m_numMisses++;
+                            return false;
+                        }
+
+                        m_numHits++;
+                        touch (entry-> second);
+                        data = entry-> second.node-> data;
+                        return true;
+                    }
+
+                    bool put (size_t id, const T& data, size_t numBytes, void (*lambda) (size_t, T*)) {
+                        size_t cost = (m_capacityType == CAPACITY_ENTRIES) ? 1 : numBytes;
+                        // entry will never fit in the shard
+                        if (cost > m_capacity)
+                            return false;
+
+                        // update existing entry, this counts as an access
+                        auto entry = m_index.find (id);
+                        if (entry != m_index.end()) {
+                            m_Node* node = entry-> second.node;
+                            node-> data = data;
+
+                            m_usage = m_usage - entry-> second.cost + cost;
+                            entry-> second.cost = cost;
+
+                            touch (entry-> second);
+                            evict (0, node, lambda);
+                            return true;
+                        }
+
+                        evict (cost, NULL, lambda);
+
+                        m_Node* node = List <T>::createNode (id, data);
+                        link (node);
+
+                        m_index.insert (std::make_pair (id, s_Entry { node, 1, cost }));
+                        m_usage += cost;
+                        return true;
+                    }
+
+                    bool erase (size_t id) {
+                        auto entry = m_index.find (id);
+                        if (entry == m_index.end())
+                            return false;
+
+                        removeNode (entry-> second.node);
+                        return true;
+                    }
+
+                    void reset (void) {
+                        List <T>::reset();
+                        m_index.clear();
+                        m_bucketTails.clear();
+                        m_usage = 0;
+
+                        m_numHits = 0;
+                        m_numMisses = 0;
+                        m_numEvictions = 0;
+                    }
+
+                    inline size_t getUsage (void) {
+                        return m_usage;
+                    }
+
+                    // in thread safe mode, every call into the shard is made with this lock held
+                    inline std::mutex& getMutex (void) {
+                        return m_mutex;
+                    }
+
+                    // named so as not to hide the list's getStats()
+                    inline s_CacheStats getCacheStats (void) {
+                        return { m_numHits, m_numMisses, m_numEvictions };
+                    }
+
+                    // entries are dumped in eviction order
+                    void dumpEntries (std::ostream& ost, void (*lambda) (T*, std::ostream&)) {
+                        for (auto it = List <T>::begin(); it != List <T>::end(); ++it) {
+                            ost << TAB_L4 << "{ " << it.getId() << ", ";  lambda (& (*it), ost);  ost << " }";
+                            if (m_policy == LFU)
+                                ost << " x " << m_index.at (it.getId()).frequency;
+                            ost << "\n";
+                        }
+                    }
+            };
+
+            size_t m_instanceId;
+            e_policy m_policy;
+            e_capacity m_capacityType;
+            size_t m_capacity;
+            bool m_threadSafe;
+
+            std::vector <Shard*> m_shards;
+            void (*m_evictionCallback) (size_t, T*);
+
+            inline Shard* getShard (size_t id) {
+                /* fibonacci hashing, every bit of the id is mixed into the high bits of the product, so that ids with a
+                 * common stride (multiples of the shard count etc.) are still spread across the shards. The high 32 bits
+                 * are then mapped onto [0, numShards) with a multiply and shift (a modulo would only look at the low bits)
+                */
+                uint64_t hash = (static_cast <uint64_t> (id) * 11400714819323198485ULL) >> 32;
+                return m_shards[(hash * m_shards.size()) >> 32];
+            }
+
+        public:
+            /* a thread safe cache is split into numShards shards, each with its own lock; a non thread safe cache always
+             * has a single shard and takes no locks
+            */
+            Cache (size_t instanceId, 
+                   e_policy policy, 
+                   e_capacity capacityType, 
+                   size_t capacity, 
+                   bool threadSafe = false, 
+                   size_t numShards = 1) {
+
+                m_instanceId = instanceId;
+                m_policy = policy;
+                m_capacityType = capacityType;
+                m_capacity = capacity;
+                m_threadSafe = threadSafe;
+                m_evictionCallback = NULL;
+
+                numShards = threadSafe ? std::max (numShards, static_cast <size_t> (1)) : 1;
+                // round up, so that every shard can hold at least one entry
+                size_t shardCapacity = (capacity + numShards - 1) / numShards;
+                for (size_t i = 0; i < numShards; i++)
+                    m_shards.push_back (new Shard (i, policy, capacityType, shardCapacity));
+            }
+
+            ~Cache (void) {
+                for (auto shard : m_shards)
+                    delete shard;
+            }
+
+            /* the callback is called with the id and data of each entry evicted to make room for a new one (not for
+             * entries removed using remove() or reset()). In thread safe mode it is called with the shard lock held, so
+             * it must not call back into the cache
+            */
+            inline void setEvictionCallback (void (*lambda) (size_t, T*)) {
+                m_evictionCallback = lambda;
+            }
+
+            // on a hit, the data is copied out and the entry is marked as accessed
+            bool get (size_t id, T& data) {
+                Shard* shard = getShard (id);
+                std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                if (m_threadSafe)
+                    lock.lock();
+
+                return shard-> get (id, data);
+            }
+
+            /* add a new entry or update an existing one, evicting entries if needed. numBytes is only used with byte
+             * capacity, returns false if the entry is larger than the capacity of a shard
+            */
+            bool put (size_t id, const T& data, size_t numBytes = sizeof (T)) {
+                Shard* shard = getShard (id);
+                std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                if (m_threadSafe)
+                    lock.lock();
+
+                return shard-> put (id, data, numBytes, m_evictionCallback);
+            }
+
+            bool remove (size_t id) {
+                Shard* shard = getShard (id);
+                std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                if (m_threadSafe)
+                    lock.lock();
+
+                return shard-> erase (id);
+            }
+
+            void reset (void) {
+                for (auto shard : m_shards) {
+                    std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                    if (m_threadSafe)
+                        lock.lock();
+
+                    shard-> reset();
+                }
+            }
+
+            size_t getSize (void) {
+                size_t numEntries = 0;
+                for (auto shard : m_shards) {
+                    std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                    if (m_threadSafe)
+                        lock.lock();
+
+                    numEntries += shard-> getSize();
+                }
+                return numEntries;
+            }
+
+            // number of entries or bytes in use, depending on the capacity type
+            size_t getUsage (void) {
+                size_t usage = 0;
+                for (auto shard : m_shards) {
+                    std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                    if (m_threadSafe)
+                        lock.lock();
+
+                    usage += shard-> getUsage();
+                }
+                return usage;
+            }
+
+            s_CacheStats getStats (void) {
+                s_CacheStats stats = { 0, 0, 0 };
+                for (auto shard : m_shards) {
+                    std::unique_lock <std::mutex> lock (shard-> getMutex(), std::defer_lock);
+                    if (m_threadSafe)
+                        lock.lock();
+
+                    s_CacheStats shardStats = shard-> getCacheStats();
+                    stats.numHits += shardStats.numHits;
+                    stats.numMisses += shardStats.numMisses;
+                    stats.numEvictions += shardStats.numEvictions;
+                }
+                return stats;
+            }
+
+            /* cache is displayed in the following format (not thread safe)
+             * cache : 
+             *      {                                   <L1>
+             *          id : ?                          <L2>
+             *          policy : ?
+             *          capacity type : ?
+             *          capacity : ?
+             *          usage : ?
+             *          entry count : ?
+             *          hits : ?
+             *          misses : ?
+             *          evictions : ?
+             *          shards :
+             *                  {                       <L3>
+             *                      { id, data }        <L4>
+             *                      ...
+             *                  }                       <L3>
+             *                  ...
+             *      }                                   <L1>
+             * 
+             * entries in each shard are listed in eviction order, along with their frequency in LFU mode
+            */
+            void dump (std::ostream& ost, 
+                       void (*lambda) (T*, std::ostream&) = [](T* data, std::ostream& ost) { 
+                                                                ost << *data; 
+                                                            }) {
+                s_CacheStats stats = getStats();
+
+                ost << "cache : " << "\n";
+                ost << OPEN_L1;
+
+                ost << TAB_L2 << "id : "            << m_instanceId                                         << "\n";
+                ost << TAB_L2 << "policy : "        << (m_policy == LRU ? "LRU" : "LFU")                    << "\n";
+                ost << TAB_L2 << "capacity type : " << (m_capacityType == CAPACITY_ENTRIES ? "ENTRIES" :
+                                                                                            "BYTES")        << "\n";
+                ost << TAB_L2 << "capacity : "      << m_capacity                                           << "\n";
+                ost << TAB_L2 << "usage : "         << getUsage()                                           << "\n";
+                ost << TAB_L2 << "entry count : "   << getSize()                                            << "\n";
+                ost << TAB_L2 << "hits : "          << stats.numHits                                        << "\n";
+                ost << TAB_L2 << "misses : "        << stats.numMisses                                      << "\n";
+                ost << TAB_L2 << "evictions : "     << stats.numEvictions                                   << "\n";
+
+                ost << TAB_L2 << "shards : "        << "\n";
+                for (auto shard : m_shards) {
+                    ost << OPEN_L3;
+                    shard-> dumpEntries (ost, lambda);
+                    ost << CLOSE_L3;
+                }
+
+                ost << CLOSE_L1;
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // CACHE_IMPL_H
\ No newline at end of file
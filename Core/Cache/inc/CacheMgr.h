@@ -0,0 +1,47 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CACHE_MGR_H
+#define CACHE_MGR_H
+
+#include "CacheImpl.h"
+
+namespace Collections {
+namespace Memory {
+    class CacheMgr: public Admin::InstanceMgr {
+        public:
+            template <typename T>
+            Cache <T>* initCache (size_t instanceId, 
+                                  e_policy policy, 
+                                  e_capacity capacityType, 
+                                  size_t capacity, 
+                                  bool threadSafe = false, 
+                                  size_t numShards = 1) {
+
+                // create and add cache object to pool
+                if (m_instancePool.find (instanceId) == m_instancePool.end()) {
+                    Cache <T>* c_cache = new Cache <T> (instanceId, policy, capacityType, capacity, threadSafe, numShards);
+
+                    Admin::NonTemplateBase* c_instance = c_cache;
+                    m_instancePool.insert (std::make_pair (instanceId, c_instance));
+                    return c_cache;
+                }
+                // instance id already exists
+                else
+                    assert (false);
+            }
+    };
+    CacheMgr cacheMgr;
+}   // namespace Memory
+}   // namespace Collections
+#endif  // CACHE_MGR_H
\ No newline at end of file
@@ -0,0 +1,266 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../inc/Cache.h"
+#include "../../../Common/LibTest/inc/LibTest.h"
+#include <thread>
+#include <random>
+
+using namespace Collections;
+
+// evicted ids, in eviction order
+std::vector <size_t> evictedIds;
+
+LIB_TEST_CASE (0, "multiple instances") {
+    auto myCache0 = CACHE_INIT (0, Memory::LRU, int, Memory::CAPACITY_ENTRIES, 4);
+    CACHE_INIT_SHARDED (1, Memory::LFU, std::string, Memory::CAPACITY_ENTRIES, 4, 2);
+
+    // or use GET_ to get cache instance
+    auto myCache1 = GET_CACHE (1, std::string);
+
+    myCache0-> CACHE_PUT (1, 26);
+    myCache1-> CACHE_PUT (1, "John");
+
+    myCache0-> CACHE_DUMP;
+    myCache1-> CACHE_DUMP;
+
+    CACHE_MGR_DUMP;
+    CACHE_CLOSE_ALL;
+    CACHE_MGR_DUMP;
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (1, "lru eviction") {
+    auto myCache = CACHE_INIT (1, Memory::LRU, int, Memory::CAPACITY_ENTRIES, 3);
+    evictedIds.clear();
+    myCache-> CACHE_ON_EVICT ([](size_t id, int* data) {
+        (void) data;
+        evictedIds.push_back (id);
+    });
+
+    myCache-> CACHE_PUT (1, 10);
+    myCache-> CACHE_PUT (2, 20);
+    myCache-> CACHE_PUT (3, 30);
+
+    // 1 is now the most recently used
+    int data;
+    if (myCache-> CACHE_GET (1, data) == false || data != 10)
+        return Quality::Test::FAIL;
+
+    // evicts 2, then 3
+    myCache-> CACHE_PUT (4, 40);
+    myCache-> CACHE_PUT (5, 50);
+    myCache-> CACHE_DUMP;
+
+    if (evictedIds != std::vector <size_t> { 2, 3 } || myCache-> CACHE_SIZE != 3)
+        return Quality::Test::FAIL;
+
+    if (myCache-> CACHE_GET (2, data) == true || myCache-> CACHE_GET (1, data) == false)
+        return Quality::Test::FAIL;
+
+    CACHE_CLOSE (1);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (2, "lfu eviction") {
+    auto myCache = CACHE_INIT (2, Memory::LFU, int, Memory::CAPACITY_ENTRIES, 3);
+    evictedIds.clear();
+    myCache-> CACHE_ON_EVICT ([](size_t id, int* data) {
+        (void) data;
+        evictedIds.push_back (id);
+    });
+
+    myCache-> CACHE_PUT (1, 10);
+    myCache-> CACHE_PUT (2, 20);
+    myCache-> CACHE_PUT (3, 30);
+
+    // frequencies { 1 : 3, 2 : 1, 3 : 2 }
+    int data;
+    myCache-> CACHE_GET (1, data);
+    myCache-> CACHE_GET (1, data);
+    myCache-> CACHE_GET (3, data);
+    myCache-> CACHE_DUMP;
+
+    // evicts 2 (lowest frequency)
+    myCache-> CACHE_PUT (4, 40);
+    // evicts 4, lowest frequency
+    myCache-> CACHE_PUT (5, 50);
+    // 5 and 3 both have frequency 2, 5 was used last so evicts 3
+    myCache-> CACHE_GET (5, data);
+    myCache-> CACHE_PUT (6, 60);
+    myCache-> CACHE_DUMP;
+
+    if (evictedIds != std::vector <size_t> { 2, 4, 3 })
+        return Quality::Test::FAIL;
+
+    CACHE_CLOSE (2);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (3, "byte capacity") {
+    auto myCache = CACHE_INIT (3, Memory::LRU, std::string, Memory::CAPACITY_BYTES, 100);
+
+    myCache-> CACHE_PUT_SIZED (1, std::string (40, 'a'), 40);
+    myCache-> CACHE_PUT_SIZED (2, std::string (40, 'b'), 40);
+    if (myCache-> CACHE_USAGE != 80)
+        return Quality::Test::FAIL;
+
+    // needs 50 bytes, evicts 1
+    myCache-> CACHE_PUT_SIZED (3, std::string (50, 'c'), 50);
+    if (myCache-> CACHE_USAGE != 90 || myCache-> CACHE_SIZE != 2)
+        return Quality::Test::FAIL;
+
+    // growing an entry evicts others, but never the entry itself
+    myCache-> CACHE_PUT_SIZED (3, std::string (90, 'c'), 90);
+    if (myCache-> CACHE_USAGE != 90 || myCache-> CACHE_SIZE != 1)
+        return Quality::Test::FAIL;
+
+    // larger than capacity
+    if (myCache-> CACHE_PUT_SIZED (4, std::string (101, 'd'), 101) == true)
+        return Quality::Test::FAIL;
+
+    CACHE_CLOSE (3);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (4, "update, remove and stats") {
+    auto myCache = CACHE_INIT (4, Memory::LRU, int, Memory::CAPACITY_ENTRIES, 2);
+
+    int data;
+    myCache-> CACHE_PUT (1, 10);
+    myCache-> CACHE_PUT (1, 11);
+    myCache-> CACHE_GET (1, data);
+    myCache-> CACHE_GET (2, data);
+    myCache-> CACHE_PUT (2, 20);
+    myCache-> CACHE_PUT (3, 30);
+
+    if (myCache-> CACHE_REMOVE (1) == true || myCache-> CACHE_REMOVE (2) == false)
+        return Quality::Test::FAIL;
+
+    Memory::s_CacheStats stats = myCache-> CACHE_STATS;
+    if (stats.numHits != 1 || stats.numMisses != 1 || stats.numEvictions != 1 || myCache-> CACHE_SIZE != 1)
+        return Quality::Test::FAIL;
+
+    myCache-> CACHE_RESET;
+    stats = myCache-> CACHE_STATS;
+    if (myCache-> CACHE_SIZE != 0 || myCache-> CACHE_USAGE != 0 || stats.numHits != 0)
+        return Quality::Test::FAIL;
+
+    CACHE_CLOSE (4);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (5, "eviction order against reference model") {
+    for (auto policy : { Memory::LRU, Memory::LFU }) {
+        auto myCache = CACHE_INIT (5, policy, size_t, Memory::CAPACITY_ENTRIES, 64);
+        evictedIds.clear();
+        myCache-> CACHE_ON_EVICT ([](size_t id, size_t* data) {
+            (void) data;
+            evictedIds.push_back (id);
+        });
+
+        // id -> { frequency, last access }
+        std::map <size_t, std::pair <size_t, size_t>> model;
+        std::vector <size_t> modelEvictedIds;
+
+        std::mt19937 generator (5);
+        std::uniform_int_distribution <size_t> distribution (0, 255);
+
+        for (size_t tick = 0; tick < 20000; tick++) {
+            size_t id = distribution (generator);
+            size_t data;
+            bool hit = model.find (id) != model.end();
+
+            if (tick % 2 == 0) {
+                if (myCache-> CACHE_GET (id, data) != hit || (hit && data != id))
+                    return Quality::Test::FAIL;
+                if (hit)
+                    model[id] = { model[id].first + 1, tick };
+                continue;
+            }
+
+            if (!hit && model.size() == 64) {
+                auto victim = model.begin();
+                for (auto it = model.begin(); it != model.end(); it++) {
+                    auto key = (policy == Memory::LRU) ? std::make_pair (size_t (0), it-> second.second) : it-> second;
+                    auto victimKey = (policy == Memory::LRU) ? std::make_pair (size_t (0), victim-> second.second) : 
+                                                               victim-> second;
+                    if (key < victimKey)
+                        victim = it;
+                }
+                modelEvictedIds.push_back (victim-> first);
+                model.erase (victim);
+            }
+
+            myCache-> CACHE_PUT (id, id);
+            model[id] = { hit ? model[id].first + 1 : 1, tick };
+        }
+
+        if (evictedIds != modelEvictedIds || myCache-> CACHE_SIZE != model.size())
+            return Quality::Test::FAIL;
+
+        CACHE_CLOSE (5);
+    }
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (6, "sharded concurrent access") {
+    auto myCache = CACHE_INIT_SHARDED (6, Memory::LFU, size_t, Memory::CAPACITY_ENTRIES, 1024, 8);
+
+    size_t numThreads = 8;
+    size_t opsPerThread = 20000;
+    std::vector <std::thread> workers;
+
+    for (size_t t = 0; t < numThreads; t++) {
+        workers.push_back (std::thread ([=]() {
+            std::mt19937 generator (t);
+            std::uniform_int_distribution <size_t> distribution (0, 4095);
+
+            for (size_t i = 0; i < opsPerThread; i++) {
+                size_t id = distribution (generator);
+                size_t data;
+                if (myCache-> CACHE_GET (id, data) == false)
+                    myCache-> CACHE_PUT (id, id);
+            }
+        }));
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    Memory::s_CacheStats stats = myCache-> CACHE_STATS;
+    std::cout << "hits : "          << stats.numHits 
+              << ", misses : "      << stats.numMisses
+              << ", evictions : "   << stats.numEvictions
+              << "\n";
+
+    if (stats.numHits + stats.numMisses != numThreads * opsPerThread)
+        return Quality::Test::FAIL;
+
+    /* each of the 8 shards holds at most 128 entries. Every entry was put after a miss, but another thread may have put
+     * the same id in between (which is an update)
+    */
+    if (myCache-> CACHE_SIZE > 1024 || myCache-> CACHE_SIZE + stats.numEvictions > stats.numMisses)
+        return Quality::Test::FAIL;
+
+    CACHE_CLOSE (6);
+    return Quality::Test::PASS;
+}
+
+int main (void) {
+    LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/Cache/");
+    LIB_TEST_RUN_ALL;
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CONCURRENT_LIST_H
+#define CONCURRENT_LIST_H
+
+#include "ConcurrentListMgr.h"
+
+/* all 'add' and 'remove' operations are lock-free and can be called from multiple threads at the same time. There are no
+ * 'set' or 'peek' operations, since the list may be updated by another thread between a peek and the operation that
+ * follows it; instead, use the 'pop' operations to remove a node and get its id and data in one step
+ *
+ * 'utils' operations are not thread safe (except CLIST_SIZE)
+*/
+
+// clist mgr methods
+#define CLIST_INIT(id, dataType)                Memory::concurrentListMgr.initConcurrentList <dataType> (id)
+#define GET_CLIST(id, dataType)                 dynamic_cast <Memory::ConcurrentList <dataType> *>              \
+                                                (Memory::concurrentListMgr.getInstance (id))
+#define CLIST_CLOSE(id)                         Memory::concurrentListMgr.closeInstance (id)
+#define CLIST_CLOSE_ALL                         Memory::concurrentListMgr.closeAllInstances()
+#define CLIST_MGR_DUMP                          Memory::concurrentListMgr.dump (std::cout)
+
+// 'add' and 'remove' operations
+#define CLIST_ADD_HEAD(id, data)                addHead (id, data)
+#define CLIST_ADD_TAIL(id, data)                addTail (id, data)
+
+#define CLIST_POP_HEAD(id, data)                popHead (id, data)
+#define CLIST_POP_TAIL(id, data)                popTail (id, data)
+#define CLIST_REMOVE_HEAD                       removeHead()
+#define CLIST_REMOVE_TAIL                       removeTail()
+
+// utils
+#define CLIST_RESET                             reset()
+#define CLIST_SIZE                              getSize()
+#define CLIST_DUMP                              dump (std::cout)
+#define CLIST_DUMP_CUSTOM(lambda)               dump (std::cout, lambda)
+#endif  // CONCURRENT_LIST_H
\ No newline at end of file
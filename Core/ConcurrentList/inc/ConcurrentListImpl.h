@@ -0,0 +1,566 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef CONCURRENT_LIST_IMPL_H
+#define CONCURRENT_LIST_IMPL_H
+
+#include "../../../Admin/InstanceMgr.h"
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <bit>
+
+// number of nodes in the first segment of the node pool, every following segment is double the size of the previous one
+#define SEGMENT_BASE_SIZE               1024
+// enough segments to address every 31 bit node index
+#define MAX_SEGMENTS                    22
+/* number of hazard records allocated along with the list (one per thread operating on the list at the same time). If more
+ * threads than this operate on the list at once, extra records are allocated as needed and kept till the list is destroyed
+*/
+#define MAX_HAZARD_RECORDS              128
+#define HAZARDS_PER_RECORD              2
+/* a hazard record tries to return its retired nodes to the free list once it holds RETIRE_FACTOR times the total number
+ * of hazard pointers
+*/
+#define RETIRE_FACTOR                   2
+#define CACHE_LINE_SIZE                 64
+
+namespace Collections {
+namespace Memory {
+    /* A lock-free deque based on "CAS-Based Lock-Free Algorithm for Shared Deques" (Maged M. Michael, 2003). Both ends of
+     * the deque are described by a single anchor word { left, right, status }, so that a push or a pop on either end is a
+     * single CAS on the anchor. A push leaves the deque in an unstable state (status = RPUSH or LPUSH) since the link from
+     * the old end node to the new end node is yet to be set; any thread that sees an unstable anchor completes the link
+     * (stabilize) before doing its own operation, which keeps the deque lock-free.
+     *
+     * To fit the anchor into a single 64 bit word, nodes are addressed using 31 bit indices into a node pool instead of
+     * pointers
+     *  anchor      [ left index (31 bits) | right index (31 bits) | status (2 bits) ]
+     *  index 0     NULL
+     *
+     * Removed nodes are not reused right away since other threads may still be reading them, instead they are retired and
+     * returned to the pool only when no thread holds a hazard pointer to them. Note that the node memory itself is only
+     * released when the list is destroyed, hazard pointers here prevent a node from being reused (and relinked) while it
+     * is being read
+    */
+    template <typename T>
+    class ConcurrentList: public Admin::NonTemplateBase {
+        private:
+            // anchor status
+            typedef enum {
+                STABLE = 0,
+                RPUSH = 1,
+                LPUSH = 2
+            }e_status;
+
+            // node definition
+            typedef struct Node {
+                size_t id;
+                // node indices
+                std::atomic <uint32_t> left;
+                std::atomic <uint32_t> right;
+                // link used only when the node is in the free list
+                std::atomic <uint32_t> nextFree;
+                T data;
+            }s_Node;
+
+            typedef struct alignas (CACHE_LINE_SIZE) HazardRecord {
+                std::atomic <bool> active;
+                std::atomic <uint32_t> hazard[HAZARDS_PER_RECORD];
+                // only accessed by the thread that holds the record
+                std::vector <uint32_t> retired;
+                // next extra record, set before the record is added to the list and never changed after that
+                HazardRecord* next;
+            }s_hazardRecord;
+
+            size_t m_instanceId;
+
+            alignas (CACHE_LINE_SIZE) std::atomic <uint64_t> m_anchor;
+            // approximate number of nodes, may be ahead of the actual count while a push is in progress
+            alignas (CACHE_LINE_SIZE) std::atomic <size_t> m_numNodes;
+            // free list head { tag (32 bits) | index (32 bits) }, the tag avoids ABA on the free list
+            alignas (CACHE_LINE_SIZE) std::atomic <uint64_t> m_freeHead;
+            // next never used index in the pool
+            alignas (CACHE_LINE_SIZE) std::atomic <uint32_t> m_nextIndex;
+
+            std::atomic <s_Node*> m_segments[MAX_SEGMENTS];
+            s_hazardRecord m_hazardRecords[MAX_HAZARD_RECORDS];
+            // records added when all the records above are active (Michael's list of hazard records), push only
+            std::atomic <s_hazardRecord*> m_extraRecords;
+            std::atomic <size_t> m_numExtraRecords;
+
+            static inline uint64_t makeAnchor (uint32_t left, uint32_t right, uint64_t status) {
+                return (static_cast <uint64_t> (left) << 33) | (static_cast <uint64_t> (right) << 2) | status;
+            }
+
+            static inline uint32_t anchorLeft (uint64_t anchor) {
+                return static_cast <uint32_t> (anchor >> 33);
+            }
+
+            static inline uint32_t anchorRight (uint64_t anchor) {
+                return static_cast <uint32_t> ((anchor >> 2) & 0x7FFFFFFF);
+            }
+
+            static inline uint64_t anchorStatus (uint64_t anchor) {
+                return anchor & 0x3;
+            }
+
+            /* segment k holds indices [BASE * (2^k - 1) + 1, BASE * (2^(k + 1) - 1)], so the segment of an index is found
+             * using the bit width of the (0 based) index scaled down by the base size
+            */
+            static inline size_t segmentOf (uint32_t index) {
+                return std::bit_width (static_cast <size_t> (index - 1) / SEGMENT_BASE_SIZE + 1) - 1;
+            }
+
+            static inline size_t segmentStart (size_t segment) {
+                return SEGMENT_BASE_SIZE * ((static_cast <size_t> (1) << segment) - 1);
+            }
+
+            inline s_Node* getNode (uint32_t index) {
+                size_t segment = segmentOf (index);
+                return m_segments[segment].load (std::memory_order_acquire) + (index - 1 - segmentStart (segment));
+            }
+
+            void pushFree (uint32_t index) {
+                s_Node* node = getNode (index);
+                uint64_t head = m_freeHead.load (std::memory_order_relaxed);
+                uint64_t newHead;
+                do {
+                    node-> nextFree.store (static_cast <uint32_t> (head), std::memory_order_relaxed);
+                    newHead = (((head >> 32) + 1) << 32) | index;
+                } while (!m_freeHead.compare_exchange_weak (head, newHead,
+                                                            std::memory_order_release,
+                                                            std::memory_order_relaxed));
+            }
+
+            uint32_t popFree (void) {
+                uint64_t head = m_freeHead.load (std::memory_order_acquire);
+                uint64_t newHead;
+                uint32_t index;
+                do {
+                    index = static_cast <uint32_t> (head);
+                    // free list is empty
+                    if (index == 0)
+                        return 0;
+
+                    uint32_t nextIndex = getNode (index)-> nextFree.load (std::memory_order_relaxed);
+                    newHead = (((head >> 32) + 1) << 32) | nextIndex;
+                } while (!m_freeHead.compare_exchange_weak (head, newHead,
+                                                            std::memory_order_acquire,
+                                                            std::memory_order_acquire));
+                return index;
+            }
+
+            // reuse a retired node if available, else take a new index from the pool (growing it if needed)
+            uint32_t createNode (size_t id, const T& data) {
+                uint32_t index = popFree();
+                if (index == 0) {
+                    index = m_nextIndex.fetch_add (1, std::memory_order_relaxed);
+                    // out of 31 bit indices
+                    assert (index <= 0x7FFFFFFF);
+
+                    size_t segment = segmentOf (index);
+                    if (m_segments[segment].load (std::memory_order_acquire) == NULL) {
+                        s_Node* newSegment = new s_Node[SEGMENT_BASE_SIZE << segment];
+                        s_Node* expected = NULL;
+                        // another thread beat us to it
+                        if (!m_segments[segment].compare_exchange_strong (expected, newSegment,
+                                                                          std::memory_order_acq_rel))
+                            delete[] newSegment;
+                    }
+                }
+
+                s_Node* newNode = getNode (index);
+                newNode-> id = id;
+                newNode-> left.store (0, std::memory_order_relaxed);
+                newNode-> right.store (0, std::memory_order_relaxed);
+                newNode-> data = data;
+                return index;
+            }
+
+            static inline bool tryAcquire (s_hazardRecord* record) {
+                bool expected = false;
+                return !record-> active.load (std::memory_order_relaxed) &&
+                        record-> active.compare_exchange_strong (expected, true, std::memory_order_acquire);
+            }
+
+            /* an inactive record is taken from the array first, then from the extra records. If every record is active, a
+             * new one is added to the extra records, so acquiring a record never waits on another thread
+            */
+            s_hazardRecord* acquireRecord (void) {
+                // start with the record this thread used last time
+                static thread_local size_t hint = 0;
+                for (size_t i = 0; i < MAX_HAZARD_RECORDS; i++) {
+                    size_t slot = (hint + i) % MAX_HAZARD_RECORDS;
+                    if (tryAcquire (&m_hazardRecords[slot])) {
+                        hint = slot;
+                        return &m_hazardRecords[slot];
+                    }
+                }
+
+                s_hazardRecord* record = m_extraRecords.load (std::memory_order_acquire);
+                for (; record != NULL; record = record-> next) {
+                    if (tryAcquire (record))
+                        return record;
+                }
+
+                s_hazardRecord* newRecord = new s_hazardRecord;
+                newRecord-> active.store (true, std::memory_order_relaxed);
+                for (auto& hazard : newRecord-> hazard)
+                    hazard.store (0, std::memory_order_relaxed);
+
+                newRecord-> next = m_extraRecords.load (std::memory_order_relaxed);
+                while (!m_extraRecords.compare_exchange_weak (newRecord-> next, newRecord,
+                                                              std::memory_order_release,
+                                                              std::memory_order_relaxed))
+                    ;
+                m_numExtraRecords.fetch_add (1, std::memory_order_relaxed);
+                return newRecord;
+            }
+
+            void releaseRecord (s_hazardRecord* record) {
+                for (auto& hazard : record-> hazard)
+                    hazard.store (0, std::memory_order_release);
+
+                record-> active.store (false, std::memory_order_release);
+            }
+
+            // set a hazard pointer and check that the anchor hasn't changed, so that the node is still in the deque
+            inline bool protect (s_hazardRecord* record, size_t slot, uint32_t index, uint64_t anchor) {
+                record-> hazard[slot].store (index);
+                return m_anchor.load() == anchor;
+            }
+
+            inline void collectHazards (s_hazardRecord* record, std::vector <uint32_t>& hazards) {
+                for (auto& hazard : record-> hazard) {
+                    uint32_t index = hazard.load();
+                    if (index != 0)
+                        hazards.push_back (index);
+                }
+            }
+
+            // return all retired nodes that are not protected by any hazard pointer to the free list
+            void scanRetired (s_hazardRecord* record) {
+                std::vector <uint32_t> hazards;
+                for (auto& hazardRecord : m_hazardRecords)
+                    collectHazards (&hazardRecord, hazards);
+
+                s_hazardRecord* extraRecord = m_extraRecords.load (std::memory_order_acquire);
+                for (; extraRecord != NULL; extraRecord = extraRecord-> next)
+                    collectHazards (extraRecord, hazards);
+                std::sort (hazards.begin(), hazards.end());
+
+                std::vector <uint32_t> stillHazardous;
+                for (auto const& index : record-> retired) {
+                    if (std::binary_search (hazards.begin(), hazards.end(), index))
+                        stillHazardous.push_back (index);
+                    else
+                        pushFree (index);
+                }
+                record-> retired.swap (stillHazardous);
+            }
+
+            void retireNode (s_hazardRecord* record, uint32_t index) {
+                record-> retired.push_back (index);
+                size_t numRecords = MAX_HAZARD_RECORDS + m_numExtraRecords.load (std::memory_order_relaxed);
+                if (record-> retired.size() >= RETIRE_FACTOR * numRecords * HAZARDS_PER_RECORD)
+                    scanRetired (record);
+            }
+
+            // complete the link from the old right end node to the new right end node
+            void stabilizeRight (s_hazardRecord* record, uint64_t anchor) {
+                uint32_t rightIndex = anchorRight (anchor);
+                if (!protect (record, 0, rightIndex, anchor))
+                    return;
+
+                uint32_t previousIndex = getNode (rightIndex)-> left.load();
+                if (!protect (record, 1, previousIndex, anchor))
+                    return;
+
+                s_Node* previousNode = getNode (previousIndex);
+                uint32_t previousNext = previousNode-> right.load();
+                if (previousNext != rightIndex) {
+                    if (m_anchor.load() != anchor)
+                        return;
+
+                    if (!previousNode-> right.compare_exchange_strong (previousNext, rightIndex))
+                        return;
+                }
+                m_anchor.compare_exchange_strong (anchor, makeAnchor (anchorLeft (anchor), rightIndex, STABLE));
+            }
+
+            // complete the link from the old left end node to the new left end node
+            void stabilizeLeft (s_hazardRecord* record, uint64_t anchor) {
+                uint32_t leftIndex = anchorLeft (anchor);
+                if (!protect (record, 0, leftIndex, anchor))
+                    return;
+
+                uint32_t nextIndex = getNode (leftIndex)-> right.load();
+                if (!protect (record, 1, nextIndex, anchor))
+                    return;
+
+                s_Node* nextNode = getNode (nextIndex);
+                uint32_t nextPrevious = nextNode-> left.load();
+                if (nextPrevious != leftIndex) {
+                    if (m_anchor.load() != anchor)
+                        return;
+
+                    if (!nextNode-> left.compare_exchange_strong (nextPrevious, leftIndex))
+                        return;
+                }
+                m_anchor.compare_exchange_strong (anchor, makeAnchor (leftIndex, anchorRight (anchor), STABLE));
+            }
+
+            void stabilize (s_hazardRecord* record, uint64_t anchor) {
+                if (anchorStatus (anchor) == RPUSH)
+                    stabilizeRight (record, anchor);
+                else
+                    stabilizeLeft (record, anchor);
+            }
+
+            void push (size_t id, const T& data, bool toTail) {
+                s_hazardRecord* record = acquireRecord();
+                uint32_t index = createNode (id, data);
+                s_Node* newNode = getNode (index);
+                m_numNodes.fetch_add (1, std::memory_order_relaxed);
+
+                while (true) {
+                    uint64_t anchor = m_anchor.load();
+                    // empty deque
+                    if (anchorRight (anchor) == 0) {
+                        if (m_anchor.compare_exchange_weak (anchor, makeAnchor (index, index, STABLE)))
+                            break;
+                    }
+                    else if (anchorStatus (anchor) == STABLE) {
+                        uint64_t newAnchor;
+                        if (toTail) {
+                            newNode-> left.store (anchorRight (anchor));
+                            newAnchor = makeAnchor (anchorLeft (anchor), index, RPUSH);
+                        }
+                        else {
+                            newNode-> right.store (anchorLeft (anchor));
+                            newAnchor = makeAnchor (index, anchorRight (anchor), LPUSH);
+                        }
+
+                        if (m_anchor.compare_exchange_weak (anchor, newAnchor)) {
+                            stabilize (record, newAnchor);
+                            break;
+                        }
+                    }
+                    // help complete another thread's push
+                    else
+                        stabilize (record, anchor);
+                }
+                releaseRecord (record);
+            }
+
+            bool pop (size_t* id, T* data, bool fromTail) {
+                s_hazardRecord* record = acquireRecord();
+                uint32_t index;
+
+                while (true) {
+                    uint64_t anchor = m_anchor.load();
+                    uint32_t leftIndex = anchorLeft (anchor);
+                    uint32_t rightIndex = anchorRight (anchor);
+
+                    // empty deque
+                    if (rightIndex == 0) {
+                        releaseRecord (record);
+                        return false;
+                    }
+
+                    // only one node left
+                    if (leftIndex == rightIndex) {
+                        if (m_anchor.compare_exchange_weak (anchor, makeAnchor (0, 0, STABLE))) {
+                            index = rightIndex;
+                            break;
+                        }
+                    }
+                    else if (anchorStatus (anchor) == STABLE) {
+                        index = fromTail ? rightIndex : leftIndex;
+                        if (!protect (record, 0, index, anchor))
+                            continue;
+
+                        uint64_t newAnchor = fromTail ?
+                                             makeAnchor (leftIndex, getNode (index)-> left.load(), STABLE) :
+                                             makeAnchor (getNode (index)-> right.load(), rightIndex, STABLE);
+
+                        if (m_anchor.compare_exchange_weak (anchor, newAnchor))
+                            break;
+                    }
+                    // help complete another thread's push
+                    else
+                        stabilize (record, anchor);
+                }
+
+                // the node is no longer in the deque, only this thread can read its contents
+                s_Node* node = getNode (index);
+                if (id != NULL)
+                    *id = node-> id;
+                if (data != NULL)
+                    *data = std::move (node-> data);
+                m_numNodes.fetch_sub (1, std::memory_order_relaxed);
+
+                record-> hazard[0].store (0, std::memory_order_release);
+                retireNode (record, index);
+                releaseRecord (record);
+                return true;
+            }
+
+            /* node contents are displayed in the following pattern
+             *      {                                   <L3>
+             *          id : ?                          <L4>
+             *          data : ?
+             *      }                                   <L3>
+            */
+            void dumpNode (s_Node* node,
+                           std::ostream& ost,
+                           void (*lambda) (T*, std::ostream&)) {
+                ost << OPEN_L3;
+                ost << TAB_L4 << "id : "            << node-> id                        << "\n";
+                ost << TAB_L4 << "data : ";         lambda (& (node-> data), ost);  ost << "\n";
+                ost << CLOSE_L3;
+            }
+
+        public:
+            ConcurrentList (size_t instanceId) {
+                m_instanceId = instanceId;
+
+                m_anchor.store (makeAnchor (0, 0, STABLE));
+                m_numNodes.store (0);
+                m_freeHead.store (0);
+                // index 0 is reserved for NULL
+                m_nextIndex.store (1);
+
+                for (auto& segment : m_segments)
+                    segment.store (NULL);
+
+                for (auto& hazardRecord : m_hazardRecords) {
+                    hazardRecord.active.store (false);
+                    for (auto& hazard : hazardRecord.hazard)
+                        hazard.store (0);
+                    hazardRecord.next = NULL;
+                }
+                m_extraRecords.store (NULL);
+                m_numExtraRecords.store (0);
+            }
+
+            ~ConcurrentList (void) {
+                // destroy all nodes
+                for (auto& segment : m_segments)
+                    delete[] segment.load();
+
+                s_hazardRecord* extraRecord = m_extraRecords.load();
+                while (extraRecord != NULL) {
+                    s_hazardRecord* nextRecord = extraRecord-> next;
+                    delete extraRecord;
+                    extraRecord = nextRecord;
+                }
+            }
+
+            void addHead (size_t id, const T& data) {
+                push (id, data, false);
+            }
+
+            void addTail (size_t id, const T& data) {
+                push (id, data, true);
+            }
+
+            /* since the deque may be updated by other threads between a peek and a remove, the only way to read a node
+             * safely is to remove it; the id and the data of the removed node are returned through id and data
+            */
+            bool popHead (size_t& id, T& data) {
+                return pop (&id, &data, false);
+            }
+
+            bool popTail (size_t& id, T& data) {
+                return pop (&id, &data, true);
+            }
+
+            bool removeHead (void) {
+                return pop (NULL, NULL, false);
+            }
+
+            bool removeTail (void) {
+                return pop (NULL, NULL, true);
+            }
+
+            /* the pool (and the node memory) is kept as it is, and all nodes are marked as unused. Note that this is not
+             * thread safe, and must be called only when no other thread is operating on the list
+            */
+            void reset (void) {
+                m_anchor.store (makeAnchor (0, 0, STABLE));
+                m_numNodes.store (0);
+                m_freeHead.store (0);
+                m_nextIndex.store (1);
+
+                for (auto& hazardRecord : m_hazardRecords)
+                    hazardRecord.retired.clear();
+
+                s_hazardRecord* extraRecord = m_extraRecords.load();
+                for (; extraRecord != NULL; extraRecord = extraRecord-> next)
+                    extraRecord-> retired.clear();
+            }
+
+            inline size_t getSize (void) {
+                return m_numNodes.load (std::memory_order_relaxed);
+            }
+
+            /* list is displayed in the following format
+             * list :
+             *      {                                   <L1>
+             *          id : ?                          <L2>
+             *          node count : ?
+             *          pool size : ?
+             *          nodes :
+             *                  {                       <L3>
+             *                      node contents       <L4>
+             *                  }
+             *                  {
+             *                      node contents
+             *                  }                       <L3>
+             *                  ...
+             *      }                                   <L1>
+             *
+             * Note that this is not thread safe, and must be called only when no other thread is operating on the list
+            */
+            void dump (std::ostream& ost,
+                       void (*lambda) (T*, std::ostream&) = [](T* nodeData, std::ostream& ost) {
+                                                                ost << *nodeData;
+                                                            }) {
+                ost << "list : " << "\n";
+                ost << OPEN_L1;
+
+                ost << TAB_L2 << "id : "            << m_instanceId             << "\n";
+                ost << TAB_L2 << "node count : "    << getSize()                << "\n";
+                ost << TAB_L2 << "pool size : "     << m_nextIndex.load() - 1   << "\n";
+
+                ost << TAB_L2 << "nodes : "         << "\n";
+                uint64_t anchor = m_anchor.load();
+                uint32_t index = anchorLeft (anchor);
+                while (index != 0) {
+                    s_Node* node = getNode (index);
+                    // dump nodes in L4
+                    dumpNode (node, ost, lambda);
+
+                    if (index == anchorRight (anchor))
+                        break;
+                    index = node-> right.load();
+                }
+
+                ost << CLOSE_L1;
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // CONCURRENT_LIST_IMPL_H
@@ -0,0 +1,247 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../inc/ConcurrentList.h"
+#include "../../../Common/LibTest/inc/LibTest.h"
+#include <thread>
+
+using namespace Collections;
+
+LIB_TEST_CASE (0, "multiple instances") {
+    auto myList0 = CLIST_INIT (0, int);
+    CLIST_INIT (1, std::string);
+
+    // or use GET_ to get list instance
+    auto myList1 = GET_CLIST (1, std::string);
+
+    myList0-> CLIST_ADD_HEAD (1, 26);
+    myList1-> CLIST_ADD_HEAD (1, "John");
+
+    myList0-> CLIST_DUMP;
+    myList1-> CLIST_DUMP;
+
+    CLIST_MGR_DUMP;
+    CLIST_CLOSE_ALL;
+    CLIST_MGR_DUMP;
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (1, "add/pop from head and tail") {
+    auto myList = CLIST_INIT (1, std::string);
+
+    std::pair <size_t, std::string> input[] = { { 1, "10" }, 
+                                                { 2, "20" },
+                                                { 3, "30" },
+                                                { 4, "40" } };
+
+    // { 4, 40 } { 2, 20 } { 1, 10 } { 3, 30 }
+    myList-> CLIST_ADD_HEAD (input[0].first, input[0].second);
+    myList-> CLIST_ADD_HEAD (input[1].first, input[1].second);
+    myList-> CLIST_ADD_TAIL (input[2].first, input[2].second);
+    myList-> CLIST_ADD_HEAD (input[3].first, input[3].second);
+    myList-> CLIST_DUMP;
+
+    if (myList-> CLIST_SIZE != 4)
+        return Quality::Test::FAIL;
+
+    size_t id;
+    std::string data;
+    size_t output[] = { 4, 3, 2, 1 };
+
+    // alternate between head and tail
+    for (size_t i = 0; i < 4; i++) {
+        bool popped = (i % 2 == 0) ? myList-> CLIST_POP_HEAD (id, data) :
+                                     myList-> CLIST_POP_TAIL (id, data);
+
+        if (popped == false || id != output[i] || data != std::to_string (output[i] * 10))
+            return Quality::Test::FAIL;
+    }
+
+    if (myList-> CLIST_SIZE != 0)
+        return Quality::Test::FAIL;
+
+    CLIST_CLOSE (1);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (2, "pop/remove from empty list") {
+    auto myList = CLIST_INIT (2, int);
+
+    size_t id;
+    int data;
+    if (myList-> CLIST_POP_HEAD (id, data) != false ||
+        myList-> CLIST_POP_TAIL (id, data) != false)
+        return Quality::Test::FAIL;
+
+    if (myList-> CLIST_REMOVE_HEAD != false ||
+        myList-> CLIST_REMOVE_TAIL != false)
+        return Quality::Test::FAIL;
+
+    myList-> CLIST_ADD_TAIL (0, 10);
+    if (myList-> CLIST_REMOVE_TAIL != true || myList-> CLIST_REMOVE_HEAD != false)
+        return Quality::Test::FAIL;
+
+    myList-> CLIST_DUMP;
+
+    CLIST_CLOSE (2);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (3, "list as queue and stack after reset") {
+    auto myList = CLIST_INIT (3, int);
+
+    for (size_t i = 0; i < 5000; i++)
+        myList-> CLIST_ADD_TAIL (i, static_cast <int> (i));
+
+    myList-> CLIST_RESET;
+    if (myList-> CLIST_SIZE != 0 || myList-> CLIST_REMOVE_HEAD != false)
+        return Quality::Test::FAIL;
+
+    for (size_t i = 0; i < 5000; i++)
+        myList-> CLIST_ADD_TAIL (i, static_cast <int> (i));
+
+    size_t id;
+    int data;
+    // queue, first in - first out
+    for (size_t i = 0; i < 2500; i++) {
+        if (myList-> CLIST_POP_HEAD (id, data) == false || id != i)
+            return Quality::Test::FAIL;
+    }
+
+    // stack, last in - first out
+    for (size_t i = 4999; i >= 2500; i--) {
+        if (myList-> CLIST_POP_TAIL (id, data) == false || id != i)
+            return Quality::Test::FAIL;
+    }
+
+    CLIST_CLOSE (3);
+    return Quality::Test::PASS;
+}
+
+/* producers add nodes with unique ids to either end, and consumers remove nodes from either end till all nodes are
+ * consumed. Every id should be removed exactly once
+*/
+bool runProducersConsumers (Memory::ConcurrentList <size_t>* myList, 
+                            size_t numThreads, 
+                            size_t nodesPerProducer) {
+    size_t numProducers = numThreads / 2;
+    size_t numNodes = numProducers * nodesPerProducer;
+
+    std::vector <std::atomic <int>> seen (numNodes);
+    std::atomic <size_t> consumed (0);
+    std::atomic <bool> valid (true);
+    std::vector <std::thread> workers;
+
+    for (size_t p = 0; p < numProducers; p++) {
+        workers.emplace_back ([myList, p, nodesPerProducer]() {
+            for (size_t i = 0; i < nodesPerProducer; i++) {
+                size_t id = p * nodesPerProducer + i;
+                // occasionally add to head
+                if (i % 8 == 0)
+                    myList-> CLIST_ADD_HEAD (id, id);
+                else
+                    myList-> CLIST_ADD_TAIL (id, id);
+            }
+        });
+    }
+
+    for (size_t c = 0; c < numThreads - numProducers; c++) {
+        workers.emplace_back ([myList, c, numNodes, &seen, &consumed, &valid]() {
+            size_t id, data, count = 0;
+            while (consumed.load() < numNodes) {
+                // occasionally remove from tail
+                bool popped = (count++ % 8 == c % 8) ? myList-> CLIST_POP_TAIL (id, data) :
+                                                       myList-> CLIST_POP_HEAD (id, data);
+                if (popped) {
+                    if (id != data || id >= numNodes || seen[id].fetch_add (1) != 0)
+                        valid.store (false);
+                    consumed.fetch_add (1);
+                }
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    return valid.load() && myList-> CLIST_SIZE == 0 && myList-> CLIST_REMOVE_HEAD == false;
+}
+
+LIB_TEST_CASE (4, "concurrent producers and consumers") {
+    auto myList = CLIST_INIT (4, size_t);
+
+    if (runProducersConsumers (myList, 8, 20000) == false)
+        return Quality::Test::FAIL;
+
+    // run again on the same list, to reuse the retired nodes
+    if (runProducersConsumers (myList, 4, 20000) == false)
+        return Quality::Test::FAIL;
+
+    CLIST_CLOSE (4);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (5, "paired add and pop") {
+    size_t opsPerThread = 100000;
+    size_t numThreads[] = { 1, 8, 16, 32 };
+
+    for (auto n : numThreads) {
+        auto myList = CLIST_INIT (5, size_t);
+        std::vector <std::thread> workers;
+        std::atomic <size_t> numPopped (0);
+        std::atomic <bool> valid (true);
+
+        // every pop follows an add from the same thread, so the list is never empty when a pop starts
+        for (size_t t = 0; t < n; t++) {
+            workers.emplace_back ([myList, opsPerThread, t, &numPopped, &valid]() {
+                size_t id, data;
+                for (size_t i = 0; i < opsPerThread; i++) {
+                    myList-> CLIST_ADD_TAIL (t, i);
+                    if (myList-> CLIST_POP_HEAD (id, data) == false)
+                        valid.store (false);
+                    else
+                        numPopped.fetch_add (1);
+                }
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (!valid.load() || numPopped.load() != n * opsPerThread || myList-> CLIST_SIZE != 0)
+            return Quality::Test::FAIL;
+
+        CLIST_CLOSE (5);
+    }
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (6, "more threads than hazard records") {
+    auto myList = CLIST_INIT (6, size_t);
+
+    // threads beyond MAX_HAZARD_RECORDS get extra hazard records instead of waiting for one to be released
+    if (runProducersConsumers (myList, MAX_HAZARD_RECORDS + 32, 500) == false)
+        return Quality::Test::FAIL;
+
+    CLIST_CLOSE (6);
+    return Quality::Test::PASS;
+}
+
+int main (void) {
+    LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/ConcurrentList/");
+    LIB_TEST_RUN_ALL;
+
+    return 0;
+}
\ No newline at end of file
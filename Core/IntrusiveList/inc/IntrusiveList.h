@@ -0,0 +1,62 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include "IntrusiveListMgr.h"
+/* an intrusive list links objects through a Memory::ListHook <dataType> member (hookName) of the object, so each list
+ * instance is tied to one hook. An object can be in as many lists as it has hooks, and the lists only ever store
+ * pointers to the objects (all add and peek operations take and return dataType*)
+*/
+
+// ilist mgr methods
+#define ILIST_INIT(id, dataType, hookName)      Memory::intrusiveListMgr.initIntrusiveList <dataType,                   \
+                                                                                            &dataType::hookName> (id)
+#define GET_ILIST(id, dataType, hookName)       dynamic_cast <Memory::IntrusiveList <dataType, &dataType::hookName> *>  \
+                                                (Memory::intrusiveListMgr.getInstance (id))
+#define ILIST_CLOSE(id)                         Memory::intrusiveListMgr.closeInstance (id)
+#define ILIST_CLOSE_ALL                         Memory::intrusiveListMgr.closeAllInstances()
+#define ILIST_MGR_DUMP                          Memory::intrusiveListMgr.dump (std::cout)
+
+// 'set' operations
+#define ILIST_PEEK_SET(object)                  peekSet (object)
+#define ILIST_PEEK_SET_HEAD                     peekSetHead()
+#define ILIST_PEEK_SET_TAIL                     peekSetTail()
+#define ILIST_PEEK_SET_NEXT                     peekSetNext()
+#define ILIST_PEEK_SET_PREVIOUS                 peekSetPrevious()
+
+// 'execute' operations (these need to be executed after a 'set' operation)
+#define ILIST_PEEK_CURRENT                      peekCurrent()
+#define ILIST_PEEK_HEAD                         peekHead()
+#define ILIST_PEEK_TAIL                         peekTail()
+
+// add operations return false if the object is already linked through the same hook
+#define ILIST_ADD_HEAD(object)                  addHead (object)
+#define ILIST_ADD_TAIL(object)                  addTail (object)
+#define ILIST_ADD_AFTER(object)                 addAfter (object)
+#define ILIST_ADD_BEFORE(object)                addBefore (object)
+
+#define ILIST_REMOVE                            remove()
+// unlink a specific object, no search needed
+#define ILIST_REMOVE_OBJECT(object)             remove (object)
+#define ILIST_REMOVE_HEAD                       removeHead()
+#define ILIST_REMOVE_TAIL                       removeTail()
+
+// utils
+#define ILIST_CONTAINS(object)                  contains (object)
+#define ILIST_RESET                             reset()
+#define ILIST_SIZE                              getSize()
+#define ILIST_DUMP                              dump (std::cout)
+#define ILIST_DUMP_CUSTOM(lambda)               dump (std::cout, lambda)
+#endif  // INTRUSIVE_LIST_H
\ No newline at end of file
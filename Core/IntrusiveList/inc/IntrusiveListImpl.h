@@ -0,0 +1,394 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef INTRUSIVE_LIST_IMPL_H
+#define INTRUSIVE_LIST_IMPL_H
+
+#include "../../../Admin/InstanceMgr.h"
+#include <iterator>
+
+namespace Collections {
+namespace Memory {
+    /* a hook is embedded in the object, one for each list the object can be on at the same time, for example
+     *      struct Task {
+     *          int priority;
+     *          ListHook <Task> readyHook;
+     *          ListHook <Task> allHook;
+     *      };
+    */
+    template <typename T>
+    struct ListHook {
+        T* next;
+        T* previous;
+        // the list the object is linked into using this hook, NULL if not linked
+        const void* list;
+
+        ListHook (void) {
+            next = NULL;
+            previous = NULL;
+            list = NULL;
+        }
+
+        inline bool isLinked (void) const {
+            return list != NULL;
+        }
+    };
+
+    /* An intrusive list links objects through a hook inside the object itself (selected by the hook template parameter),
+     * so the list never allocates or copies anything; it only links and unlinks objects that are owned by someone else.
+     * The objects must outlive their membership in the list, and destroying the list unlinks every object in it
+     *
+     * the list has the same peek position based set and update methods as List, except that objects are identified by
+     * their address instead of a node id
+    */
+    template <typename T, ListHook <T> T::* hook>
+    class IntrusiveList: public Admin::NonTemplateBase {
+        private:
+            size_t m_instanceId;
+            size_t m_numObjects;
+
+            T* m_headObject;
+            T* m_tailObject;
+            T* m_peekObject;
+
+            static inline ListHook <T>& getHook (T* object) {
+                return object->* hook;
+            }
+
+            // link a new object after the OOI (object of interest), OOI is expected to be in the list
+            void linkAfter (T* currentObject, T* newObject) {
+                T* nextObject = getHook (currentObject).next;
+
+                getHook (currentObject).next = newObject;
+                getHook (newObject).previous = currentObject;
+
+                getHook (newObject).next = nextObject;
+                // if OOI is the tail object
+                if (nextObject == NULL)
+                    m_tailObject = newObject;
+                else
+                    getHook (nextObject).previous = newObject;
+            }
+
+            // link a new object before the OOI (object of interest), OOI is expected to be in the list
+            void linkBefore (T* currentObject, T* newObject) {
+                T* previousObject = getHook (currentObject).previous;
+
+                getHook (newObject).next = currentObject;
+                getHook (currentObject).previous = newObject;
+
+                getHook (newObject).previous = previousObject;
+                // if OOI is the head object
+                if (previousObject == NULL)
+                    m_headObject = newObject;
+                else
+                    getHook (previousObject).next = newObject;
+            }
+
+            // an object can only be added if its hook is not already in use (by this or any other list)
+            inline bool claim (T* object) {
+                if (object == NULL || getHook (object).isLinked())
+                    return false;
+
+                getHook (object).list = this;
+                m_numObjects++;
+                return true;
+            }
+
+        public:
+            /* bidirectional iterator over the objects in the list, end() is a NULL object, decrementing it moves the
+             * iterator to the tail object
+            */
+            class Iterator {
+                private:
+                    T* m_iterObject;
+                    const IntrusiveList* m_list;
+
+                public:
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef T* pointer;
+                    typedef T& reference;
+
+                    Iterator (void) {
+                        m_iterObject = NULL;
+                        m_list = NULL;
+                    }
+
+                    Iterator (T* object, const IntrusiveList* list) {
+                        m_iterObject = object;
+                        m_list = list;
+                    }
+
+                    inline T& operator * (void) const {
+                        return *m_iterObject;
+                    }
+
+                    inline T* operator -> (void) const {
+                        return m_iterObject;
+                    }
+
+                    inline Iterator& operator ++ (void) {
+                        m_iterObject = getHook (m_iterObject).next;
+                        return *this;
+                    }
+
+                    inline Iterator operator ++ (int) {
+                        Iterator iter = *this;
+                        ++(*this);
+                        return iter;
+                    }
+
+                    inline Iterator& operator -- (void) {
+                        m_iterObject = (m_iterObject == NULL) ? m_list-> m_tailObject : getHook (m_iterObject).previous;
+                        return *this;
+                    }
+
+                    inline Iterator operator -- (int) {
+                        Iterator iter = *this;
+                        --(*this);
+                        return iter;
+                    }
+
+                    inline bool operator == (const Iterator& other) const {
+                        return m_iterObject == other.m_iterObject;
+                    }
+            };
+            typedef Iterator iterator;
+
+            IntrusiveList (size_t instanceId) {
+                m_instanceId = instanceId;
+                m_numObjects = 0;
+
+                m_headObject = NULL;
+                m_tailObject = NULL;
+                m_peekObject = NULL;
+            }
+
+            ~IntrusiveList (void) {
+                // leave the hooks of the objects free for other lists
+                reset();
+            }
+
+            // peek position is set to NULL if the object is not in this list
+            inline void peekSet (T* object) {
+                m_peekObject = contains (object) ? object : NULL;
+            }
+
+            inline void peekSetHead (void) {
+                m_peekObject = m_headObject;
+            }
+
+            inline void peekSetTail (void) {
+                m_peekObject = m_tailObject;
+            }
+
+            void peekSetNext (void) {
+                if (m_peekObject == NULL)
+                    return;
+
+                m_peekObject = getHook (m_peekObject).next;
+            }
+
+            void peekSetPrevious (void) {
+                if (m_peekObject == NULL)
+                    return;
+
+                m_peekObject = getHook (m_peekObject).previous;
+            }
+
+            inline T* peekCurrent (void) {
+                return m_peekObject;
+            }
+
+            inline T* peekHead (void) {
+                return m_headObject;
+            }
+
+            inline T* peekTail (void) {
+                return m_tailObject;
+            }
+
+            inline bool contains (T* object) {
+                return object != NULL && getHook (object).list == this;
+            }
+
+            // returns false if the object is already linked using this hook
+            bool addHead (T* object) {
+                if (!claim (object))
+                    return false;
+
+                getHook (object).previous = NULL;
+                getHook (object).next = NULL;
+                // if new object is the only object in the list
+                if (m_headObject == NULL) {
+                    m_headObject = object;
+                    m_tailObject = object;
+                }
+                else
+                    linkBefore (m_headObject, object);
+                return true;
+            }
+
+            bool addTail (T* object) {
+                if (!claim (object))
+                    return false;
+
+                getHook (object).previous = NULL;
+                getHook (object).next = NULL;
+                // if new object is the only object in the list
+                if (m_tailObject == NULL) {
+                    m_headObject = object;
+                    m_tailObject = object;
+                }
+                else
+                    linkAfter (m_tailObject, object);
+                return true;
+            }
+
+            bool addAfter (T* object) {
+                // peek position is not valid
+                if (m_peekObject == NULL || !claim (object))
+                    return false;
+
+                linkAfter (m_peekObject, object);
+                return true;
+            }
+
+            bool addBefore (T* object) {
+                // peek position is not valid
+                if (m_peekObject == NULL || !claim (object))
+                    return false;
+
+                linkBefore (m_peekObject, object);
+                return true;
+            }
+
+            // unlink the object from this list, returns false if the object is not in this list
+            bool remove (T* object) {
+                if (!contains (object))
+                    return false;
+
+                ListHook <T>& objectHook = getHook (object);
+                // if OOI is tail object
+                if (object == m_tailObject)
+                    m_tailObject = objectHook.previous;
+                else
+                    getHook (objectHook.next).previous = objectHook.previous;
+
+                // if OOI is head object
+                if (object == m_headObject)
+                    m_headObject = objectHook.next;
+                else
+                    getHook (objectHook.previous).next = objectHook.next;
+
+                // set peek position to NULL since the object is no longer in the list
+                if (object == m_peekObject)
+                    m_peekObject = NULL;
+
+                objectHook.next = NULL;
+                objectHook.previous = NULL;
+                objectHook.list = NULL;
+                m_numObjects--;
+                return true;
+            }
+
+            inline bool remove (void) {
+                return remove (m_peekObject);
+            }
+
+            bool removeHead (void) {
+                // set peek position to head
+                peekSetHead();
+                return remove();
+            }
+
+            bool removeTail (void) {
+                // set peek position to tail
+                peekSetTail();
+                return remove();
+            }
+
+            // unlink all objects, the objects themselves are left untouched
+            void reset (void) {
+                T* currentObject = m_headObject;
+                while (currentObject != NULL) {
+                    ListHook <T>& objectHook = getHook (currentObject);
+                    T* nextObject = objectHook.next;
+
+                    objectHook.next = NULL;
+                    objectHook.previous = NULL;
+                    objectHook.list = NULL;
+
+                    currentObject = nextObject;
+                }
+
+                m_numObjects = 0;
+                m_headObject = NULL;
+                m_tailObject = NULL;
+                m_peekObject = NULL;
+            }
+
+            inline size_t getSize (void) {
+                return m_numObjects;
+            }
+
+            inline iterator begin (void) {
+                return iterator (m_headObject, this);
+            }
+
+            inline iterator end (void) {
+                return iterator (NULL, this);
+            }
+
+            /* list is displayed in the following format
+             * intrusive list : 
+             *      {                                   <L1>
+             *          id : ?                          <L2>
+             *          object count : ?
+             *          objects :
+             *                  {                       <L3>
+             *                      address : ?         <L4>
+             *                      data : ?
+             *                  }                       <L3>
+             *                  ...
+             *      }                                   <L1>
+             *
+             * objects have no default way to be displayed, so a lambda is needed to dump them
+            */
+            void dump (std::ostream& ost, 
+                       void (*lambda) (T*, std::ostream&) = [](T* object, std::ostream& ost) { 
+                                                                (void) object;
+                                                                ost << "?"; 
+                                                            }) {
+                ost << "intrusive list : " << "\n";
+                ost << OPEN_L1;
+
+                ost << TAB_L2 << "id : "            << m_instanceId     << "\n";
+                ost << TAB_L2 << "object count : "  << getSize()        << "\n";
+
+                ost << TAB_L2 << "objects : "       << "\n";
+                for (T* object = m_headObject; object != NULL; object = getHook (object).next) {
+                    ost << OPEN_L3;
+                    ost << TAB_L4 << "address : "   << object           << "\n";
+                    ost << TAB_L4 << "data : ";     lambda (object, ost);  ost << "\n";
+                    ost << CLOSE_L3;
+                }
+
+                ost << CLOSE_L1;
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // INTRUSIVE_LIST_IMPL_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../inc/IntrusiveList.h"
+#include "../../../Common/LibTest/inc/LibTest.h"
+#include <vector>
+#include <algorithm>
+
+using namespace Collections;
+
+struct Task {
+    int priority;
+    Memory::ListHook <Task> readyHook;
+    Memory::ListHook <Task> allHook;
+};
+
+LIB_TEST_CASE (0, "multiple instances") {
+    auto myList0 = ILIST_INIT (0, Task, readyHook);
+    ILIST_INIT (1, Task, allHook);
+
+    // or use GET_ to get list instance
+    auto myList1 = GET_ILIST (1, Task, allHook);
+
+    Task task { 1, {}, {} };
+    myList0-> ILIST_ADD_HEAD (&task);
+    myList1-> ILIST_ADD_HEAD (&task);
+
+    auto lambda = [](Task* task, std::ostream& ost) {
+        ost << task-> priority;
+    };
+    myList0-> ILIST_DUMP_CUSTOM (lambda);
+    myList1-> ILIST_DUMP_CUSTOM (lambda);
+
+    ILIST_MGR_DUMP;
+    ILIST_CLOSE_ALL;
+    ILIST_MGR_DUMP;
+
+    // closing the lists unlinks the object
+    if (task.readyHook.isLinked() || task.allHook.isLinked())
+        return Quality::Test::FAIL;
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (1, "add and remove") {
+    auto myList = ILIST_INIT (1, Task, readyHook);
+    std::vector <Task> pool (5);
+    for (int i = 0; i < 5; i++)
+        pool[i].priority = i;
+
+    // { 1 } { 0 } { 2 }
+    myList-> ILIST_ADD_TAIL (&pool[0]);
+    myList-> ILIST_ADD_HEAD (&pool[1]);
+    myList-> ILIST_ADD_TAIL (&pool[2]);
+    // { 1 } { 3 } { 0 } { 4 } { 2 }
+    myList-> ILIST_PEEK_SET (&pool[0]);
+    myList-> ILIST_ADD_BEFORE (&pool[3]);
+    myList-> ILIST_ADD_AFTER (&pool[4]);
+
+    // already linked
+    if (myList-> ILIST_ADD_TAIL (&pool[3]) == true || myList-> ILIST_SIZE != 5)
+        return Quality::Test::FAIL;
+
+    int output[] = { 1, 3, 0, 4, 2 };
+    int i = 0;
+    for (auto& task : *myList) {
+        if (task.priority != output[i++])
+            return Quality::Test::FAIL;
+    }
+
+    // backward
+    i = 4;
+    myList-> ILIST_PEEK_SET_TAIL;
+    while (myList-> ILIST_PEEK_CURRENT != NULL) {
+        if (myList-> ILIST_PEEK_CURRENT-> priority != output[i--])
+            return Quality::Test::FAIL;
+        myList-> ILIST_PEEK_SET_PREVIOUS;
+    }
+
+    // { 3 } { 4 }
+    myList-> ILIST_REMOVE_OBJECT (&pool[0]);
+    myList-> ILIST_REMOVE_HEAD;
+    myList-> ILIST_REMOVE_TAIL;
+    if (myList-> ILIST_SIZE != 2 || myList-> ILIST_PEEK_HEAD != &pool[3] || myList-> ILIST_PEEK_TAIL != &pool[4])
+        return Quality::Test::FAIL;
+
+    // removed objects can be added again
+    if (pool[0].readyHook.isLinked() || myList-> ILIST_ADD_TAIL (&pool[0]) == false)
+        return Quality::Test::FAIL;
+
+    // not in list
+    if (myList-> ILIST_REMOVE_OBJECT (&pool[1]) == true)
+        return Quality::Test::FAIL;
+
+    ILIST_CLOSE (1);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (2, "object on multiple lists") {
+    auto readyList = ILIST_INIT (2, Task, readyHook);
+    auto allList = ILIST_INIT (3, Task, allHook);
+    std::vector <Task> pool (10);
+
+    for (int i = 0; i < 10; i++) {
+        pool[i].priority = i;
+        allList-> ILIST_ADD_TAIL (&pool[i]);
+        // even tasks are ready
+        if (i % 2 == 0)
+            readyList-> ILIST_ADD_HEAD (&pool[i]);
+    }
+
+    // unlinking from one list doesn't affect the other
+    readyList-> ILIST_REMOVE_OBJECT (&pool[4]);
+    if (readyList-> ILIST_SIZE != 4 || allList-> ILIST_SIZE != 10 || !allList-> ILIST_CONTAINS (&pool[4]))
+        return Quality::Test::FAIL;
+
+    if (readyList-> ILIST_CONTAINS (&pool[4]) || readyList-> ILIST_CONTAINS (&pool[3]))
+        return Quality::Test::FAIL;
+
+    int readyOutput[] = { 8, 6, 2, 0 };
+    if (!std::equal (readyList-> begin(), readyList-> end(), readyOutput, [](const Task& task, int priority) {
+        return task.priority == priority;
+    }))
+        return Quality::Test::FAIL;
+
+    auto iter = std::find_if (allList-> begin(), allList-> end(), [](const Task& task) {
+        return task.priority == 7;
+    });
+    if (iter == allList-> end() || & (*iter) != &pool[7])
+        return Quality::Test::FAIL;
+
+    // reset only unlinks, objects are untouched
+    allList-> ILIST_RESET;
+    if (allList-> ILIST_SIZE != 0 || pool[5].allHook.isLinked() || pool[5].priority != 5)
+        return Quality::Test::FAIL;
+
+    ILIST_CLOSE (2);
+    ILIST_CLOSE (3);
+    return Quality::Test::PASS;
+}
+
+int main (void) {
+    LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/IntrusiveList/");
+    LIB_TEST_RUN_ALL;
+
+    return 0;
+}
\ No newline at end of file
@@ -23,6 +23,27 @@
 #define LIST_CLOSE(id)                          Memory::listMgr.closeInstance (id)
 #define LIST_CLOSE_ALL                          Memory::listMgr.closeAllInstances()
 #define LIST_MGR_DUMP                           Memory::listMgr.dump (std::cout)
+// dump the stats of every list instance, instances with stats disabled show up with zero counts
+#define LIST_MGR_DUMP_STATS                     Memory::listMgr.dump (std::cout, Memory::ListMgr::dumpStats)
+
+/* cursors are independent peek positions in the list, create one using LIST_CURSOR (starts at the current peek position)
+ * and use the same 'set' and 'execute' operations on it, for example
+ *      auto myCursor = myList-> LIST_CURSOR;
+ *      myCursor.LIST_PEEK_SET_HEAD;
+ *      myCursor.LIST_PEEK_CURRENT;
+ *
+ * the following operations are available on a cursor
+ * LIST_PEEK_SET
+ * LIST_PEEK_SET_HEAD
+ * LIST_PEEK_SET_TAIL
+ * LIST_PEEK_SET_NEXT
+ * LIST_PEEK_SET_PREVIOUS
+ * LIST_PEEK_CURRENT
+ * LIST_ADD_AFTER
+ * LIST_ADD_BEFORE
+ * LIST_REMOVE
+*/
+#define LIST_CURSOR                             getCursor()
 
 // 'set' operations
 #define LIST_PEEK_SET(id)                       peekSet (id)
@@ -40,14 +61,81 @@
 #define LIST_ADD_TAIL(id, data)                 addTail (id, data)
 #define LIST_ADD_AFTER(id, data)                addAfter (id, data)
 #define LIST_ADD_BEFORE(id, data)               addBefore (id, data)
+/* construct the node data in place, the arguments after the id are passed on to the data type's constructor (e.g.
+ * LIST_EMPLACE_TAIL (1, 5, 'a') adds a std::string "aaaaa")
+*/
+#define LIST_EMPLACE_HEAD(id, ...)              emplaceHead (id, __VA_ARGS__)
+#define LIST_EMPLACE_TAIL(id, ...)              emplaceTail (id, __VA_ARGS__)
+#define LIST_EMPLACE_AFTER(id, ...)             emplaceAfter (id, __VA_ARGS__)
+#define LIST_EMPLACE_BEFORE(id, ...)            emplaceBefore (id, __VA_ARGS__)
+// insert a range of { id, data } pairs after/before the peek node, linked in as a single chain
+#define LIST_INSERT_AFTER(range)                insertAfter (range)
+#define LIST_INSERT_BEFORE(range)               insertBefore (range)
+#define LIST_INSERT_SORTED(id, data)            insertSorted (id, data)
+#define LIST_INSERT_SORTED_CUSTOM(id,                                                                           \
+                                  data,                                                                         \
+                                  lambda)       insertSorted (id, data, lambda)
 
 #define LIST_REMOVE                             remove()
 #define LIST_REMOVE_HEAD                        removeHead()
 #define LIST_REMOVE_TAIL                        removeTail()
+/* remove all nodes between two cursors (both included), nothing is removed if cursorB is before cursorA or if either
+ * cursor was created on another list
+*/
+#define LIST_ERASE_RANGE(cursorA, cursorB)      eraseRange (cursorA, cursorB)
+// remove a node and move its id and data out into id and data
+#define LIST_POP(id, data)                      pop (id, data)
+#define LIST_POP_HEAD(id, data)                 popHead (id, data)
+#define LIST_POP_TAIL(id, data)                 popTail (id, data)
+
+// search, returns an iterator (end() if not found), peek position is left unchanged
+#define LIST_FIND(data)                         find (data)
+#define LIST_FIND_IF(lambda)                    findIf (lambda)
+#define LIST_COUNT_IF(lambda)                   countIf (lambda)
+#define LIST_REMOVE_IF(lambda)                  removeIf (lambda)
 
 // utils
 #define LIST_REVERSE                            reverse()
 #define LIST_SWAP(idA, idB)                     swap (idA, idB)
+#define LIST_SORT                               sort()
+#define LIST_SORT_CUSTOM(lambda)                sort (lambda)
+#define LIST_SORT_PARALLEL(numThreads)          sortParallel (numThreads)
+#define LIST_SORT_PARALLEL_CUSTOM(numThreads,                                                                   \
+                                  lambda)       sortParallel (numThreads, lambda)
+/* publish the current state of the list (writer only), readers can then take a snapshot of it from any thread and walk
+ * it without locking (only taking the snapshot briefly locks a mutex shared with publish). Every publish is a full copy
+ * of the list (O(n) time and memory, no structure is shared between versions), so publish once per batch of changes
+ * rather than after every small change. For example
+ *      auto mySnapshot = myList-> LIST_SNAPSHOT;
+ *      for (auto const& [id, data] : mySnapshot)
+ *          ...
+ *
+ * the following operations are available on a snapshot
+ * LIST_SIZE
+ * LIST_SNAPSHOT_VERSION
+*/
+#define LIST_PUBLISH                            publish()
+#define LIST_SNAPSHOT                           snapshot()
+#define LIST_SNAPSHOT_VERSION                   getVersion()
+/* binary save and load, load replaces the contents of the list. Use the _CUSTOM variants for data that is not trivially
+ * copyable, with a serializer lambda (T*, std::string&) that appends the bytes of the data to the string, and a
+ * deserializer lambda (T*, const char*, size_t) that rebuilds the data from them
+*/
+#define LIST_SAVE(fileName)                     save (fileName)
+#define LIST_SAVE_CUSTOM(fileName, lambda)      save (fileName, lambda)
+#define LIST_LOAD(fileName)                     load (fileName)
+#define LIST_LOAD_CUSTOM(fileName, lambda)      load (fileName, lambda)
+/* read only view of a saved file, straight from the mapped file without building a list. The following operations are
+ * available on a mapped view: isValid(), getSize(), getId (index), getData (index), begin(), end()
+*/
+#define LIST_MAP_FILE(fileName)                 mapFile (fileName)
+/* operation counters, off by default (compile with LIST_STATS_ON defined to turn them on for every instance). Stats are
+ * returned as an s_ListStats struct
+*/
+#define LIST_STATS_ENABLE                       enableStats (true)
+#define LIST_STATS_DISABLE                      enableStats (false)
+#define LIST_STATS                              getStats()
+#define LIST_STATS_RESET                        resetStats()
 #define LIST_RESET                              reset()
 #define LIST_SIZE                               getSize()
 #define LIST_DUMP                               dump (std::cout)
@@ -15,50 +15,233 @@
 #define LIST_IMPL_H
 
 #include "../../../Admin/InstanceMgr.h"
+#include "ListStats.h"
+#include <vector>
+#include <thread>
+#include <iterator>
+#include <ranges>
+#include <memory>
+#include <mutex>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// minimum number of nodes per thread for sortParallel() to actually split the work across threads
+#define PARALLEL_SORT_MIN_CHUNK         4096
+/* nodes are allocated from slabs owned by the list, the first slab holds LIST_SLAB_MIN_NODES nodes and each new slab
+ * doubles in size up to LIST_SLAB_MAX_NODES
+*/
+#define LIST_SLAB_MIN_NODES             16
+#define LIST_SLAB_MAX_NODES             65536
+// "CLST", first 4 bytes of a list file
+#define LIST_FILE_MAGIC                 0x54534C43
 
 namespace Collections {
 namespace Memory {
+    /* the non template base is virtual so that a type built on top of a list (without exposing the list's interface, see
+     * SkipList) can still be held by an instance mgr
+    */
     template <typename T>
-    class List: public Admin::NonTemplateBase {
-        private:
+    class List: public virtual Admin::NonTemplateBase, public ListInstrumentation {
+        protected:
             // node definition
             typedef struct Node {
                 size_t id;
                 Node* next;
                 Node* previous;
                 T data;
+
+                // node data is constructed in place from the arguments, i.e. copied from a const T&, moved from a T&&
+                template <typename... Args>
+                Node (size_t nodeId, Args&&... args) : data (std::forward <Args> (args)...) {
+                    id = nodeId;
+                    next = NULL;
+                    previous = NULL;
+                }
             }s_Node;
 
-            size_t m_instanceId;
             size_t m_numNodes;
 
             s_Node* m_headNode;
             s_Node* m_tailNode;
             s_Node* m_peekNode;
-            
-            s_Node* createNode (size_t id, const T& data) {
-                s_Node* newNode = new s_Node;
-                m_numNodes++;
 
-                newNode-> id = id;
-                newNode-> next = NULL;
-                newNode-> previous = NULL;
-                newNode-> data = data;
+            template <typename... Args>
+            s_Node* createNode (size_t id, Args&&... args) {
+                s_Node* newNode = new (allocateNode()) s_Node (id, std::forward <Args> (args)...);
+                m_numNodes++;
+                countAdd();
                 return newNode;
             }
 
+            // destroy a node that has already been unlinked, its memory is kept by the list to be reused
+            void destroyNode (s_Node* node) {
+                node-> ~s_Node();
+                countRemove();
+
+                s_FreeNode* freeNode = reinterpret_cast <s_FreeNode*> (node);
+                freeNode-> next = m_freeNodes;
+                m_freeNodes = freeNode;
+            }
+
+            // link new node after the NOI (node of interest), NOI is expected to be a valid node in the list
+            void linkAfter (s_Node* currentNode, s_Node* newNode) {
+                s_Node* nextNode = currentNode-> next;
+
+                // create link
+                currentNode-> next = newNode;
+                newNode-> previous = currentNode;
+
+                newNode-> next = nextNode;
+                // if NOI is the tail node
+                if (nextNode == NULL)
+                    m_tailNode = newNode;
+                else
+                    nextNode-> previous = newNode;
+            }
+
+            // link new node before the NOI (node of interest), NOI is expected to be a valid node in the list
+            void linkBefore (s_Node* currentNode, s_Node* newNode) {
+                s_Node* previousNode = currentNode-> previous;
+
+                // create link
+                newNode-> next = currentNode;
+                currentNode-> previous = newNode;
+
+                newNode-> previous = previousNode;
+                // if NOI is the head node
+                if (previousNode == NULL)
+                    m_headNode = newNode;
+                else
+                    previousNode-> next = newNode;
+            }
+
+            /* unlink the NOI (node of interest) from the list, the node itself is not destroyed. If the NOI is the peek
+             * node, the peek position is set to NULL
+            */
+            void unlinkNode (s_Node* currentNode) {
+                // if NOI is tail node
+                if (currentNode == m_tailNode)
+                    m_tailNode = currentNode-> previous;
+                else
+                    currentNode-> next-> previous = currentNode-> previous;
+
+                // if NOI is head node
+                if (currentNode == m_headNode)
+                    m_headNode = currentNode-> next;
+                else
+                    currentNode-> previous-> next = currentNode-> next;
+
+                // set peek position to NULL since the node is no longer in the list
+                if (currentNode == m_peekNode)
+                    m_peekNode = NULL;
+
+                m_numNodes--;
+            }
+
+        private:
+            size_t m_instanceId;
+
+            /* node arena, nodes are carved out of slabs in order and destroyed nodes are put on a free list to be reused.
+             * Memory is only given back when the list is reset (or destroyed), at which point whole slabs are released
+             * at once instead of one node at a time; for trivially destructible data, no node needs to be visited at all
+            */
+            typedef struct FreeNode {
+                FreeNode* next;
+            }s_FreeNode;
+
+            std::vector <std::pair <s_Node*, size_t>> m_slabs;
+            s_Node* m_slabCursor;
+            s_Node* m_slabEnd;
+            s_FreeNode* m_freeNodes;
+
+            void* allocateNode (void) {
+                if (m_freeNodes != NULL) {
+                    s_FreeNode* freeNode = m_freeNodes;
+                    m_freeNodes = freeNode-> next;
+                    return freeNode;
+                }
+
+                if (m_slabCursor == m_slabEnd) {
+                    size_t numSlabNodes = m_slabs.empty() ? LIST_SLAB_MIN_NODES : 
+                                                            std::min (m_slabs.back().second * 2, 
+                                                                      static_cast <size_t> (LIST_SLAB_MAX_NODES));
+                    s_Node* slab = std::allocator <s_Node>().allocate (numSlabNodes);
+                    m_slabs.push_back (std::make_pair (slab, numSlabNodes));
+
+                    m_slabCursor = slab;
+                    m_slabEnd = slab + numSlabNodes;
+                }
+                return m_slabCursor++;
+            }
+
+            void releaseSlabs (void) {
+                for (auto const& [slab, numSlabNodes] : m_slabs)
+                    std::allocator <s_Node>().deallocate (slab, numSlabNodes);
+
+                m_slabs.clear();
+                m_slabCursor = NULL;
+                m_slabEnd = NULL;
+                m_freeNodes = NULL;
+            }
+
+            /* build a chain of new nodes (not yet linked into the list) from a range of { id, data } pairs, returns the
+             * first and last node of the chain (both NULL if the range is empty). The data is moved out of an rvalue
+             * range
+            */
+            template <typename R>
+            std::pair <s_Node*, s_Node*> createChain (R&& range) {
+                s_Node* firstNode = NULL;
+                s_Node* lastNode = NULL;
+
+                for (auto&& entry : range) {
+                    s_Node* newNode;
+                    if constexpr (std::is_rvalue_reference <R&&>::value)
+                        newNode = createNode (entry.first, std::move (entry.second));
+                    else
+                        newNode = createNode (entry.first, entry.second);
+
+                    if (lastNode == NULL)
+                        firstNode = newNode;
+                    else {
+                        lastNode-> next = newNode;
+                        newNode-> previous = lastNode;
+                    }
+                    lastNode = newNode;
+                }
+                return std::make_pair (firstNode, lastNode);
+            }
+
+            // a published version of the list, holds a copy of the node ids and data in list order
+            typedef struct Version {
+                size_t version;
+                std::vector <std::pair <size_t, T>> entries;
+            }s_Version;
+
+            /* readers take snapshots while the writer publishes. The mutex only guards the pointer swap and copy (not
+             * std::atomic <std::shared_ptr>, which libc++ does not provide and libstdc++ implements with a lock anyway)
+            */
+            std::shared_ptr <const s_Version> m_publishedVersion;
+            mutable std::mutex m_versionMutex;
+            size_t m_numVersions;
+
             s_Node* getNode (size_t id) {
                 // if id is not found (invalid), this method returns NULL
 
                 // set head node as start point of search
                 s_Node* currentNode  = m_headNode;
+                size_t numNodesVisited = 0;
                 while (currentNode != NULL) {
+                    numNodesVisited++;
                     // id found
                     if (currentNode-> id == id)
                         break;
                 
                     currentNode = currentNode-> next;
                 }
+                countLookup (numNodesVisited);
                 return currentNode;
             }
 
@@ -87,7 +270,453 @@ namespace Memory {
                 ost << CLOSE_L3;
             }
 
+            /* detach a run of (at most) 'length' nodes starting at runNode from the rest of the chain, and return the
+             * first node of the rest of the chain (NULL if there are no nodes left). Only the next links are used here,
+             * the previous links are rebuilt once the sort is complete
+            */
+            static s_Node* splitRun (s_Node* runNode, size_t length) {
+                for (size_t i = 1; runNode != NULL && i < length; i++)
+                    runNode = runNode-> next;
+
+                if (runNode == NULL)
+                    return NULL;
+
+                s_Node* restNode = runNode-> next;
+                runNode-> next = NULL;
+                return restNode;
+            }
+
+            /* merge two sorted runs and append the result to tailLink, returns the link at the end of the merged run so
+             * that the next merge can be appended to it. A node is picked from runB only if it is strictly less than the
+             * node in runA, which keeps the merge (and therefore the sort) stable
+            */
+            static s_Node** mergeRuns (s_Node* runA,
+                                       s_Node* runB,
+                                       s_Node** tailLink,
+                                       bool (*lambda) (T*, T*)) {
+                while (runA != NULL && runB != NULL) {
+                    if (lambda (& (runB-> data), & (runA-> data))) {
+                        *tailLink = runB;
+                        runB = runB-> next;
+                    }
+                    else {
+                        *tailLink = runA;
+                        runA = runA-> next;
+                    }
+                    tailLink = & ((*tailLink)-> next);
+                }
+
+                // append whatever is left over
+                *tailLink = (runA != NULL) ? runA : runB;
+                while (*tailLink != NULL)
+                    tailLink = & ((*tailLink)-> next);
+
+                return tailLink;
+            }
+
+            /* bottom-up merge sort of a NULL terminated chain of 'numNodes' nodes, linked only through the next links.
+             * Runs of width 1, 2, 4 ... are merged pairwise until a single run remains, so no recursion or auxiliary
+             * storage is needed. Returns the new first node of the chain. This doesn't touch any list state, and so can
+             * be run concurrently on disjoint chains
+            */
+            static s_Node* sortChain (s_Node* chainNode,
+                                      size_t numNodes,
+                                      bool (*lambda) (T*, T*)) {
+                for (size_t width = 1; width < numNodes; width *= 2) {
+                    s_Node* pendingNode = chainNode;
+                    s_Node* mergedNode = NULL;
+                    s_Node** tailLink = &mergedNode;
+
+                    while (pendingNode != NULL) {
+                        s_Node* runA = pendingNode;
+                        s_Node* runB = splitRun (runA, width);
+                        pendingNode = splitRun (runB, width);
+
+                        tailLink = mergeRuns (runA, runB, tailLink, lambda);
+                    }
+                    chainNode = mergedNode;
+                }
+                return chainNode;
+            }
+
+            // rebuild previous links and the tail node after the chain has been relinked using only the next links
+            void relinkPrevious (s_Node* chainNode) {
+                s_Node* previousNode = NULL;
+                m_headNode = chainNode;
+
+                while (chainNode != NULL) {
+                    chainNode-> previous = previousNode;
+                    previousNode = chainNode;
+                    chainNode = chainNode-> next;
+                }
+                m_tailNode = previousNode;
+            }
+
+            /* list file layout (native byte order), all sections are contiguous so that a file can be loaded in one
+             * pass or used in place once it is mapped
+             *
+             * [header]
+             * [node ids]           numNodes x uint64_t
+             * [data sizes]         numNodes x uint64_t (FILE_CUSTOM only)
+             * [data]               at dataOffset, numNodes x sizeof (T) for FILE_TRIVIAL (aligned for T), or the bytes
+             *                      written by the serializer lambda for FILE_CUSTOM
+            */
+            typedef enum {
+                FILE_TRIVIAL = 1,
+                FILE_CUSTOM = 2
+            }e_fileFormat;
+
+            typedef struct FileHeader {
+                uint32_t magic;
+                uint32_t format;
+                uint64_t numNodes;
+                // sizeof (T) for FILE_TRIVIAL, total number of data bytes for FILE_CUSTOM
+                uint64_t dataSize;
+                uint64_t dataOffset;
+            }s_FileHeader;
+
+            // read only mapping of a list file, the file is unmapped when this is destroyed
+            class FileMapping {
+                private:
+                    void* m_address;
+                    size_t m_size;
+
+                public:
+                    FileMapping (const std::string& fileName) {
+                        m_address = NULL;
+                        m_size = 0;
+
+                        int fileDescriptor = open (fileName.c_str(), O_RDONLY);
+                        if (fileDescriptor == -1)
+                            return;
+
+                        struct stat fileStat;
+                        if (fstat (fileDescriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+                            void* address = mmap (NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                            if (address != MAP_FAILED) {
+                                m_address = address;
+                                m_size = fileStat.st_size;
+                            }
+                        }
+                        // the mapping stays valid after the file is closed
+                        close (fileDescriptor);
+                    }
+
+                    ~FileMapping (void) {
+                        if (m_address != NULL)
+                            munmap (m_address, m_size);
+                    }
+
+                    FileMapping (const FileMapping&) = delete;
+                    FileMapping& operator = (const FileMapping&) = delete;
+
+                    inline const char* getAddress (void) const {
+                        return static_cast <const char*> (m_address);
+                    }
+
+                    // returns NULL if the mapping is not a complete list file of the given format
+                    const s_FileHeader* getHeader (uint32_t format) const {
+                        if (m_address == NULL || m_size < sizeof (s_FileHeader))
+                            return NULL;
+
+                        const s_FileHeader* header = static_cast <const s_FileHeader*> (m_address);
+                        if (header-> magic != LIST_FILE_MAGIC || header-> format != format)
+                            return NULL;
+
+                        size_t numArrays = (format == FILE_CUSTOM) ? 2 : 1;
+                        if (header-> numNodes > m_size / (numArrays * sizeof (uint64_t)))
+                            return NULL;
+
+                        size_t arraysEnd = sizeof (s_FileHeader) + numArrays * header-> numNodes * sizeof (uint64_t);
+                        size_t dataSize = (format == FILE_CUSTOM) ? header-> dataSize : 
+                                                                    header-> numNodes * sizeof (T);
+                        if (format == FILE_TRIVIAL && header-> dataSize != sizeof (T))
+                            return NULL;
+
+                        if (header-> dataOffset < arraysEnd || header-> dataOffset > m_size || 
+                            m_size - header-> dataOffset < dataSize)
+                            return NULL;
+
+                        return header;
+                    }
+            };
+
+            // write everything up to the data section
+            static void writeHeader (std::ofstream& file, const s_FileHeader& header, const std::vector <uint64_t>& arrays) {
+                file.write (reinterpret_cast <const char*> (&header), sizeof (s_FileHeader));
+                file.write (reinterpret_cast <const char*> (arrays.data()), arrays.size() * sizeof (uint64_t));
+
+                // pad up to data offset
+                size_t numPadBytes = header.dataOffset - sizeof (s_FileHeader) - arrays.size() * sizeof (uint64_t);
+                for (size_t i = 0; i < numPadBytes; i++)
+                    file.put (0);
+            }
+
         public:
+            /* a cursor is an independent position in the list, it shares the same set, peek and update methods with the
+             * list's own peek position, i.e. peekSetNext(), peekCurrent(), addAfter(), remove() etc. Any number of cursors
+             * can be created on a list, and moving a cursor doesn't affect the peek position of the list or any other
+             * cursor. So, multiple readers can walk the same list at the same time (as long as no one is updating it),
+             * and nested traversals don't need to save and restore the list's peek position
+             *
+             * Note that a cursor holds a pointer to its node, so removing a node (either through the list or through
+             * another cursor) that a cursor is currently at, leaves that cursor invalid
+            */
+            class Cursor {
+                private:
+                    List* m_list;
+                    s_Node* m_cursorNode;
+
+                public:
+                    Cursor (List* list, s_Node* node) {
+                        m_list = list;
+                        m_cursorNode = node;
+                    }
+
+                    inline void peekSet (size_t id) {
+                        m_list-> countPeekSet();
+                        m_cursorNode = m_list-> getNode (id);
+                    }
+
+                    inline void peekSetHead (void) {
+                        m_cursorNode = m_list-> m_headNode;
+                    }
+
+                    inline void peekSetTail (void) {
+                        m_cursorNode = m_list-> m_tailNode;
+                    }
+
+                    void peekSetNext (void) {
+                        if (m_cursorNode == NULL)
+                            return;
+
+                        m_cursorNode = m_cursorNode-> next;
+                    }
+
+                    void peekSetPrevious (void) {
+                        if (m_cursorNode == NULL)
+                            return;
+
+                        m_cursorNode = m_cursorNode-> previous;
+                    }
+
+                    inline s_Node* peekCurrent (void) const {
+                        return m_cursorNode;
+                    }
+
+                    // the list this cursor was created on
+                    inline const List* getList (void) const {
+                        return m_list;
+                    }
+
+                    bool addAfter (size_t id, const T& data) {
+                        // cursor is not at a valid node
+                        if (m_cursorNode == NULL)
+                            return false;
+
+                        m_list-> linkAfter (m_cursorNode, m_list-> createNode (id, data));
+                        return true;
+                    }
+
+                    bool addBefore (size_t id, const T& data) {
+                        // cursor is not at a valid node
+                        if (m_cursorNode == NULL)
+                            return false;
+
+                        m_list-> linkBefore (m_cursorNode, m_list-> createNode (id, data));
+                        return true;
+                    }
+
+                    // same as the list's remove(), the cursor is set to NULL after the node is removed
+                    bool remove (void) {
+                        // cursor is not at a valid node
+                        if (m_cursorNode == NULL)
+                            return false;
+
+                        m_list-> unlinkNode (m_cursorNode);
+                        m_list-> destroyNode (m_cursorNode);
+
+                        m_cursorNode = NULL;
+                        return true;
+                    }
+            };
+
+            /* bidirectional iterator over the node data, this allows the list to be used in range based for loops and
+             * with the std algorithms (the list models std::ranges::bidirectional_range). The node id can be retrieved
+             * from the iterator using getId(). end() is a NULL node, decrementing it moves the iterator to the tail node
+             *
+             * Same as with cursors, removing the node an iterator is currently at, leaves that iterator invalid
+            */
+            template <bool isConst>
+            class Iterator {
+                private:
+                    typedef typename std::conditional <isConst, const s_Node, s_Node>::type t_node;
+
+                    t_node* m_iterNode;
+                    const List* m_list;
+
+                    // allow conversion from iterator to const iterator
+                    friend class Iterator <!isConst>;
+
+                public:
+                    typedef std::bidirectional_iterator_tag iterator_category;
+                    typedef T value_type;
+                    typedef std::ptrdiff_t difference_type;
+                    typedef typename std::conditional <isConst, const T*, T*>::type pointer;
+                    typedef typename std::conditional <isConst, const T&, T&>::type reference;
+
+                    Iterator (void) {
+                        m_iterNode = NULL;
+                        m_list = NULL;
+                    }
+
+                    Iterator (t_node* node, const List* list) {
+                        m_iterNode = node;
+                        m_list = list;
+                    }
+
+                    template <bool wasConst, typename = typename std::enable_if <isConst && !wasConst>::type>
+                    Iterator (const Iterator <wasConst>& other) {
+                        m_iterNode = other.m_iterNode;
+                        m_list = other.m_list;
+                    }
+
+                    inline reference operator * (void) const {
+                        return m_iterNode-> data;
+                    }
+
+                    inline pointer operator -> (void) const {
+                        return & (m_iterNode-> data);
+                    }
+
+                    inline size_t getId (void) const {
+                        return m_iterNode-> id;
+                    }
+
+                    inline Iterator& operator ++ (void) {
+                        m_iterNode = m_iterNode-> next;
+                        return *this;
+                    }
+
+                    inline Iterator operator ++ (int) {
+                        Iterator iter = *this;
+                        ++(*this);
+                        return iter;
+                    }
+
+                    inline Iterator& operator -- (void) {
+                        m_iterNode = (m_iterNode == NULL) ? m_list-> m_tailNode : m_iterNode-> previous;
+                        return *this;
+                    }
+
+                    inline Iterator operator -- (int) {
+                        Iterator iter = *this;
+                        --(*this);
+                        return iter;
+                    }
+
+                    inline bool operator == (const Iterator& other) const {
+                        return m_iterNode == other.m_iterNode;
+                    }
+            };
+            typedef Iterator <false> iterator;
+            typedef Iterator <true> const_iterator;
+
+            /* read only view of a list file (written by save()), served directly from the mapped file; no list is built
+             * and no data is copied, so the view is ready as soon as the file is mapped. Nodes are accessed by their
+             * index (position in the list when it was saved). Only for trivially copyable data
+            */
+            class MappedView {
+                private:
+                    std::shared_ptr <FileMapping> m_mapping;
+
+                    const uint64_t* m_ids;
+                    const T* m_data;
+                    size_t m_numNodes;
+
+                public:
+                    MappedView (const std::string& fileName) {
+                        static_assert (std::is_trivially_copyable <T>::value, "mapped view needs trivially copyable data");
+                        m_mapping = std::make_shared <FileMapping> (fileName);
+                        m_ids = NULL;
+                        m_data = NULL;
+                        m_numNodes = 0;
+
+                        const s_FileHeader* header = m_mapping-> getHeader (FILE_TRIVIAL);
+                        if (header == NULL)
+                            return;
+
+                        const char* address = m_mapping-> getAddress();
+                        m_ids = reinterpret_cast <const uint64_t*> (address + sizeof (s_FileHeader));
+                        m_data = reinterpret_cast <const T*> (address + header-> dataOffset);
+                        m_numNodes = header-> numNodes;
+                    }
+
+                    // false if the file could not be mapped or is not a valid list file for this data type
+                    inline bool isValid (void) const {
+                        return m_ids != NULL;
+                    }
+
+                    inline size_t getSize (void) const {
+                        return m_numNodes;
+                    }
+
+                    inline size_t getId (size_t index) const {
+                        return m_ids[index];
+                    }
+
+                    inline const T& getData (size_t index) const {
+                        return m_data[index];
+                    }
+
+                    // iterate over the data in list order
+                    inline const T* begin (void) const {
+                        return m_data;
+                    }
+
+                    inline const T* end (void) const {
+                        return m_data + m_numNodes;
+                    }
+            };
+
+            /* a snapshot is an immutable view of the list as it was the last time it was published. The writer thread
+             * calls publish() to make the current state of the list visible, while any number of reader threads take a
+             * snapshot() and walk it without any locks, even as the writer goes on mutating the list. Taking a snapshot
+             * briefly locks a mutex shared with publish() to copy the version pointer, walking it does not. A new version
+             * is created on every publish and older versions are never modified; a version is reclaimed once the last
+             * snapshot holding it is destroyed (snapshots can outlive the list itself)
+             *
+             * entries in a snapshot are { id, data } pairs, in list order
+            */
+            class Snapshot {
+                private:
+                    std::shared_ptr <const s_Version> m_version;
+
+                public:
+                    typedef typename std::vector <std::pair <size_t, T>>::const_iterator const_iterator;
+
+                    Snapshot (std::shared_ptr <const s_Version> version) {
+                        m_version = version;
+                    }
+
+                    inline const_iterator begin (void) const {
+                        return m_version-> entries.begin();
+                    }
+
+                    inline const_iterator end (void) const {
+                        return m_version-> entries.end();
+                    }
+
+                    inline size_t getSize (void) const {
+                        return m_version-> entries.size();
+                    }
+
+                    // version 0 is the empty list, before the first publish
+                    inline size_t getVersion (void) const {
+                        return m_version-> version;
+                    }
+            };
+
             List (size_t instanceId) {
                 m_instanceId = instanceId;
                 m_numNodes = 0;
@@ -95,6 +724,13 @@ namespace Memory {
                 m_headNode = NULL;
                 m_tailNode = NULL;
                 m_peekNode = NULL;
+
+                m_publishedVersion = std::make_shared <const s_Version> ();
+                m_numVersions = 0;
+
+                m_slabCursor = NULL;
+                m_slabEnd = NULL;
+                m_freeNodes = NULL;
             }
 
             ~List (void) {
@@ -103,6 +739,7 @@ namespace Memory {
             }
 
             inline void peekSet (size_t id) {
+                countPeekSet();
                 m_peekNode = getNode (id);
             }
 
@@ -132,6 +769,11 @@ namespace Memory {
                 return m_peekNode;
             }
 
+            // create a new cursor starting at the current peek position
+            inline Cursor getCursor (void) {
+                return Cursor (this, m_peekNode);
+            }
+
             inline s_Node* peekHead (void) {
                 return m_headNode;
             }
@@ -140,8 +782,10 @@ namespace Memory {
                 return m_tailNode;
             }
 
-            void addHead (size_t id, const T& data) {
-                s_Node* newNode = createNode (id, data);
+            // construct the node data in place using the arguments (same as T's constructor arguments)
+            template <typename... Args>
+            void emplaceHead (size_t id, Args&&... args) {
+                s_Node* newNode = createNode (id, std::forward <Args> (args)...);
                 // create link
                 if (m_headNode != NULL) {
                     newNode-> next = m_headNode;
@@ -156,8 +800,9 @@ namespace Memory {
                 m_headNode = newNode;
             }
 
-            void addTail (size_t id, const T& data) {
-                s_Node* newNode = createNode (id, data);
+            template <typename... Args>
+            void emplaceTail (size_t id, Args&&... args) {
+                s_Node* newNode = createNode (id, std::forward <Args> (args)...);
                 // create link
                 if (m_headNode != NULL) {
                     m_tailNode-> next = newNode;
@@ -172,53 +817,59 @@ namespace Memory {
                 m_tailNode = newNode;
             }
 
-            bool addAfter (size_t id, const T& data) {
+            template <typename... Args>
+            bool emplaceAfter (size_t id, Args&&... args) {
                 s_Node* currentNode = peekCurrent();
                 // id not found
                 if (currentNode == NULL)
                     return false;
 
-                // if NOI is the tail node
-                if (currentNode == m_tailNode)
-                    addTail (id, data);    
-
-                else {
-                    s_Node* newNode = createNode (id, data);
-                    // save link
-                    s_Node* nextNode = currentNode-> next;
-
-                    // create link
-                    currentNode-> next = newNode;
-                    newNode-> previous = currentNode;
-
-                    newNode-> next = nextNode;
-                    nextNode-> previous = newNode;
-                }       
+                linkAfter (currentNode, createNode (id, std::forward <Args> (args)...));
                 return true;     
             }
 
-            bool addBefore (size_t id, const T& data) {
+            template <typename... Args>
+            bool emplaceBefore (size_t id, Args&&... args) {
                 s_Node* currentNode = peekCurrent();
                 // id not found
                 if (currentNode == NULL)
                     return false;
 
-                // if NOI is the head node
-                if (currentNode == m_headNode)
-                    addHead (id, data);
+                linkBefore (currentNode, createNode (id, std::forward <Args> (args)...));
+                return true;
+            }
 
-                else {
-                    s_Node* newNode = createNode (id, data);
-                    s_Node* previousNode = currentNode-> previous;
+            // the rvalue overloads move the data into the node instead of copying it
+            inline void addHead (size_t id, const T& data) {
+                emplaceHead (id, data);
+            }
 
-                    // create link
-                    previousNode-> next = newNode;
-                    newNode-> previous = previousNode;
+            inline void addHead (size_t id, T&& data) {
+                emplaceHead (id, std::move (data));
+            }
 
-                    newNode-> next = currentNode;
-                    currentNode-> previous = newNode;
-                }
-                return true;
+            inline void addTail (size_t id, const T& data) {
+                emplaceTail (id, data);
+            }
+
+            inline void addTail (size_t id, T&& data) {
+                emplaceTail (id, std::move (data));
+            }
+
+            inline bool addAfter (size_t id, const T& data) {
+                return emplaceAfter (id, data);
+            }
+
+            inline bool addAfter (size_t id, T&& data) {
+                return emplaceAfter (id, std::move (data));
+            }
+
+            inline bool addBefore (size_t id, const T& data) {
+                return emplaceBefore (id, data);
+            }
+
+            inline bool addBefore (size_t id, T&& data) {
+                return emplaceBefore (id, std::move (data));
             }
 
             bool remove (void) {
@@ -227,24 +878,9 @@ namespace Memory {
                 if (currentNode == NULL)
                     return false;
 
-                // if NOI is tail node
-                if (currentNode == m_tailNode)
-                    m_tailNode = currentNode-> previous;
-                else
-                    currentNode-> next-> previous = currentNode-> previous;
-
-                // if NOI is head node
-                if (currentNode == m_headNode)
-                    m_headNode = currentNode-> next;
-                else
-                    currentNode-> previous-> next = currentNode-> next;
-
+                unlinkNode (currentNode);
                 // remove node
-                delete currentNode;
-                // set peek position to NULL since we have removed the node
-                m_peekNode = NULL;
-
-                m_numNodes--;
+                destroyNode (currentNode);
                 return true;
             }
             
@@ -260,6 +896,185 @@ namespace Memory {
                 return remove();
             }
 
+            /* same as remove(), but the node id and data are handed back to the caller; the data is moved out of the node
+             * before it is destroyed
+            */
+            bool pop (size_t& id, T& data) {
+                s_Node* currentNode = peekCurrent();
+                // id not found
+                if (currentNode == NULL)
+                    return false;
+
+                id = currentNode-> id;
+                data = std::move (currentNode-> data);
+
+                unlinkNode (currentNode);
+                // remove node
+                destroyNode (currentNode);
+                return true;
+            }
+
+            bool popHead (size_t& id, T& data) {
+                // set peek position to head
+                peekSetHead();
+                return pop (id, data);
+            }
+
+            bool popTail (size_t& id, T& data) {
+                // set peek position to tail
+                peekSetTail();
+                return pop (id, data);
+            }
+
+            // iterator at the first node with data equal to the given data, end() if there is no such node
+            iterator find (const T& data) {
+                s_Node* currentNode = m_headNode;
+                while (currentNode != NULL && !(currentNode-> data == data))
+                    currentNode = currentNode-> next;
+
+                return iterator (currentNode, this);
+            }
+
+            // iterator at the first node for which the lambda returns true, end() if there is no such node
+            iterator findIf (bool (*lambda) (T*)) {
+                s_Node* currentNode = m_headNode;
+                while (currentNode != NULL && !lambda (& (currentNode-> data)))
+                    currentNode = currentNode-> next;
+
+                return iterator (currentNode, this);
+            }
+
+            size_t countIf (bool (*lambda) (T*)) {
+                size_t count = 0;
+                for (s_Node* currentNode = m_headNode; currentNode != NULL; currentNode = currentNode-> next)
+                    count += lambda (& (currentNode-> data)) ? 1 : 0;
+
+                return count;
+            }
+
+            /* insert a range of { id, data } pairs (e.g. a std::vector <std::pair <size_t, T>>, or a snapshot) after the
+             * peek node, keeping the order of the range. The new nodes are chained together first and then linked into
+             * the list in one step
+            */
+            template <typename R>
+            bool insertAfter (R&& range) {
+                s_Node* currentNode = peekCurrent();
+                // id not found
+                if (currentNode == NULL)
+                    return false;
+
+                auto [firstNode, lastNode] = createChain (std::forward <R> (range));
+                // empty range
+                if (firstNode == NULL)
+                    return true;
+
+                s_Node* nextNode = currentNode-> next;
+                currentNode-> next = firstNode;
+                firstNode-> previous = currentNode;
+
+                lastNode-> next = nextNode;
+                // if NOI is the tail node
+                if (nextNode == NULL)
+                    m_tailNode = lastNode;
+                else
+                    nextNode-> previous = lastNode;
+                return true;
+            }
+
+            template <typename R>
+            bool insertBefore (R&& range) {
+                s_Node* currentNode = peekCurrent();
+                // id not found
+                if (currentNode == NULL)
+                    return false;
+
+                auto [firstNode, lastNode] = createChain (std::forward <R> (range));
+                // empty range
+                if (firstNode == NULL)
+                    return true;
+
+                s_Node* previousNode = currentNode-> previous;
+                currentNode-> previous = lastNode;
+                lastNode-> next = currentNode;
+
+                firstNode-> previous = previousNode;
+                // if NOI is the head node
+                if (previousNode == NULL)
+                    m_headNode = firstNode;
+                else
+                    previousNode-> next = firstNode;
+                return true;
+            }
+
+            /* remove all nodes from the first cursor's node to the last cursor's node (both included). The span is unlinked
+             * from the list in one step and its nodes are then destroyed, returns the number of nodes removed (0 if either
+             * cursor is not at a valid node or belongs to another list, or if the last cursor is before the first cursor).
+             * Like remove(), cursors at removed nodes are left invalid and the peek position is set to NULL if it was in
+             * the span
+            */
+            size_t eraseRange (const Cursor& firstCursor, const Cursor& lastCursor) {
+                // the span would be unlinked from this list and its nodes released to this list's slabs
+                if (firstCursor.getList() != this || lastCursor.getList() != this)
+                    return 0;
+
+                s_Node* firstNode = firstCursor.peekCurrent();
+                s_Node* lastNode = lastCursor.peekCurrent();
+                if (firstNode == NULL || lastNode == NULL)
+                    return 0;
+
+                // the last node has to be reachable from the first node
+                size_t numRemoved = 1;
+                for (s_Node* currentNode = firstNode; currentNode != lastNode; currentNode = currentNode-> next) {
+                    if (currentNode-> next == NULL)
+                        return 0;
+                    numRemoved++;
+                }
+
+                s_Node* previousNode = firstNode-> previous;
+                s_Node* nextNode = lastNode-> next;
+                if (previousNode == NULL)
+                    m_headNode = nextNode;
+                else
+                    previousNode-> next = nextNode;
+
+                if (nextNode == NULL)
+                    m_tailNode = previousNode;
+                else
+                    nextNode-> previous = previousNode;
+
+                // the span is still chained through its next links
+                s_Node* currentNode = firstNode;
+                while (currentNode != nextNode) {
+                    s_Node* spanNode = currentNode-> next;
+                    if (currentNode == m_peekNode)
+                        m_peekNode = NULL;
+
+                    destroyNode (currentNode);
+                    currentNode = spanNode;
+                }
+
+                m_numNodes -= numRemoved;
+                return numRemoved;
+            }
+
+            /* remove all nodes for which the lambda returns true in a single pass, returns the number of nodes removed.
+             * If the peek node is removed, the peek position is set to NULL
+            */
+            size_t removeIf (bool (*lambda) (T*)) {
+                size_t numRemoved = 0;
+                s_Node* currentNode = m_headNode;
+                while (currentNode != NULL) {
+                    s_Node* nextNode = currentNode-> next;
+                    if (lambda (& (currentNode-> data))) {
+                        unlinkNode (currentNode);
+                        destroyNode (currentNode);
+                        numRemoved++;
+                    }
+                    currentNode = nextNode;
+                }
+                return numRemoved;
+            }
+
             void reverse (void) {
                 s_Node* currentNode = m_headNode;
                 // if list is empty
@@ -287,6 +1102,7 @@ namespace Memory {
             }
 
             bool swap (size_t idA, size_t idB) {
+                countSwap();
                 // no need to swap if both ids are same
                 if (idA == idB)
                     return true;
@@ -352,14 +1168,131 @@ namespace Memory {
                 return true;
             }
 
-            void reset (void) {
+            /* sort the list in place using the lambda as the 'less than' comparator. The nodes are relinked rather than
+             * copied, so no allocations are made and node pointers (including the peek node) remain valid after the sort.
+             * The sort is stable, nodes that compare equal retain their relative order
+            */
+            void sort (bool (*lambda) (T*, T*) = [](T* dataA, T* dataB) {
+                                                    return *dataA < *dataB;
+                                                }) {
+                if (m_numNodes < 2)
+                    return;
+
+                relinkPrevious (sortChain (m_headNode, m_numNodes, lambda));
+            }
+
+            /* the list is split into (at most) numThreads chunks of roughly equal size, each chunk is sorted on its own
+             * thread and the sorted chunks are then merged pairwise (again in parallel) till a single chunk remains. The
+             * chunks are merged in list order, so this is stable as well. Note that the lambda will be called from
+             * multiple threads at once
+             *
+             * for small lists the thread overhead outweighs the gain, so we fall back to the single threaded sort
+            */
+            void sortParallel (size_t numThreads,
+                               bool (*lambda) (T*, T*) = [](T* dataA, T* dataB) {
+                                                            return *dataA < *dataB;
+                                                        }) {
+                if (numThreads < 2 || m_numNodes < numThreads * PARALLEL_SORT_MIN_CHUNK) {
+                    sort (lambda);
+                    return;
+                }
+
+                // split into chunks, the last chunk takes the remainder
+                std::vector <std::pair <s_Node*, size_t>> chunks;
+                size_t chunkSize = m_numNodes / numThreads;
+                s_Node* pendingNode = m_headNode;
+
+                for (size_t i = 0; i < numThreads; i++) {
+                    size_t length = (i == numThreads - 1) ? m_numNodes - chunkSize * i : chunkSize;
+                    chunks.push_back ({ pendingNode, length });
+                    pendingNode = splitRun (pendingNode, length);
+                }
+
+                // sort chunks
+                std::vector <std::thread> workers;
+                for (auto& chunk : chunks)
+                    workers.emplace_back ([&chunk, lambda]() {
+                        chunk.first = sortChain (chunk.first, chunk.second, lambda);
+                    });
+
+                for (auto& worker : workers)
+                    worker.join();
+
+                // merge adjacent chunks pairwise till one remains
+                while (chunks.size() > 1) {
+                    std::vector <std::pair <s_Node*, size_t>> mergedChunks ((chunks.size() + 1) / 2);
+                    workers.clear();
+
+                    for (size_t i = 0; i < chunks.size(); i += 2) {
+                        // odd chunk out is carried over to the next round as it is
+                        if (i + 1 == chunks.size()) {
+                            mergedChunks[i / 2] = chunks[i];
+                            continue;
+                        }
+
+                        workers.emplace_back ([&chunks, &mergedChunks, i, lambda]() {
+                            s_Node* mergedNode = NULL;
+                            mergeRuns (chunks[i].first, chunks[i + 1].first, &mergedNode, lambda);
+                            mergedChunks[i / 2] = { mergedNode, chunks[i].second + chunks[i + 1].second };
+                        });
+                    }
+
+                    for (auto& worker : workers)
+                        worker.join();
+
+                    chunks = mergedChunks;
+                }
+
+                relinkPrevious (chunks[0].first);
+            }
+
+            /* insert a new node before the first node that is greater than the new node (using the lambda as the 'less
+             * than' comparator), so the list is expected to already be sorted using the same lambda. Nodes that compare
+             * equal to the new node will stay ahead of it, the same as if the new node was added to the tail and the list
+             * was then sorted. There is no id or order index in the list to jump to the position, so this is a linear
+             * search; but, since the most common case is to insert in ascending order, the tail node is checked first
+             *
+             * peek position is left unchanged
+            */
+            void insertSorted (size_t id,
+                               const T& data,
+                               bool (*lambda) (T*, T*) = [](T* dataA, T* dataB) {
+                                                            return *dataA < *dataB;
+                                                        }) {
+                s_Node* newNode = createNode (id, data);
+                // empty list
+                if (m_tailNode == NULL) {
+                    m_headNode = newNode;
+                    m_tailNode = newNode;
+                    return;
+                }
+
+                // new node goes after the tail node
+                if (!lambda (& (newNode-> data), & (m_tailNode-> data))) {
+                    linkAfter (m_tailNode, newNode);
+                    return;
+                }
+
                 s_Node* currentNode = m_headNode;
-                while (currentNode != NULL) {
-                    s_Node* nextNode = currentNode-> next;
-                    delete currentNode;
+                while (!lambda (& (newNode-> data), & (currentNode-> data)))
+                    currentNode = currentNode-> next;
 
-                    currentNode = nextNode;
+                linkBefore (currentNode, newNode);
+            }
+
+            void reset (void) {
+                countReset();
+                // node memory is released a slab at a time, so only the data destructors need a walk over the nodes
+                if constexpr (!std::is_trivially_destructible <T>::value) {
+                    s_Node* currentNode = m_headNode;
+                    while (currentNode != NULL) {
+                        s_Node* nextNode = currentNode-> next;
+                        currentNode-> ~s_Node();
+
+                        currentNode = nextNode;
+                    }
                 }
+                releaseSlabs();
 
                 // reset stats
                 m_numNodes = 0;
@@ -372,6 +1305,170 @@ namespace Memory {
                 return m_numNodes;
             }
 
+            /* make the current state of the list visible to snapshots. This copies every node (O(n) time and memory per
+             * publish, nothing is shared with the previous version), so it is meant to be called by the writer once a batch
+             * of changes is complete, not after every change. Only the writer thread (the thread that mutates the list) may
+             * call this
+            */
+            void publish (void) {
+                std::shared_ptr <s_Version> newVersion = std::make_shared <s_Version> ();
+                newVersion-> version = ++m_numVersions;
+
+                newVersion-> entries.reserve (m_numNodes);
+                for (s_Node* node = m_headNode; node != NULL; node = node-> next)
+                    newVersion-> entries.emplace_back (node-> id, node-> data);
+
+                std::lock_guard <std::mutex> lock (m_versionMutex);
+                m_publishedVersion = std::move (newVersion);
+            }
+
+            // save the list to a binary file, only for trivially copyable data (use the serializer lambda otherwise)
+            bool save (const std::string& fileName) {
+                static_assert (std::is_trivially_copyable <T>::value, "use save() with a serializer lambda");
+
+                std::vector <uint64_t> ids;
+                ids.reserve (m_numNodes);
+                for (s_Node* node = m_headNode; node != NULL; node = node-> next)
+                    ids.push_back (node-> id);
+
+                s_FileHeader header;
+                header.magic = LIST_FILE_MAGIC;
+                header.format = FILE_TRIVIAL;
+                header.numNodes = m_numNodes;
+                header.dataSize = sizeof (T);
+                // align data for T, so that the file can be used in place once mapped
+                size_t arraysEnd = sizeof (s_FileHeader) + m_numNodes * sizeof (uint64_t);
+                header.dataOffset = (arraysEnd + alignof (T) - 1) / alignof (T) * alignof (T);
+
+                std::ofstream file (fileName, std::ios::binary | std::ios::trunc);
+                if (!file)
+                    return false;
+
+                writeHeader (file, header, ids);
+                for (s_Node* node = m_headNode; node != NULL; node = node-> next)
+                    file.write (reinterpret_cast <const char*> (& (node-> data)), sizeof (T));
+
+                file.close();
+                return file.good();
+            }
+
+            // the lambda appends the bytes of the node data to the string
+            bool save (const std::string& fileName, void (*lambda) (T*, std::string&)) {
+                std::vector <uint64_t> arrays (2 * m_numNodes);
+                std::string data;
+
+                size_t i = 0;
+                for (s_Node* node = m_headNode; node != NULL; node = node-> next, i++) {
+                    size_t previousSize = data.size();
+                    lambda (& (node-> data), data);
+
+                    arrays[i] = node-> id;
+                    arrays[m_numNodes + i] = data.size() - previousSize;
+                }
+
+                s_FileHeader header;
+                header.magic = LIST_FILE_MAGIC;
+                header.format = FILE_CUSTOM;
+                header.numNodes = m_numNodes;
+                header.dataSize = data.size();
+                header.dataOffset = sizeof (s_FileHeader) + arrays.size() * sizeof (uint64_t);
+
+                std::ofstream file (fileName, std::ios::binary | std::ios::trunc);
+                if (!file)
+                    return false;
+
+                writeHeader (file, header, arrays);
+                file.write (data.data(), data.size());
+
+                file.close();
+                return file.good();
+            }
+
+            /* replace the contents of the list with a file written by save(), the file is mapped and the list is built
+             * in a single pass over it. Returns false (and the list is left unchanged) if the file is not a valid list
+             * file for this data type
+            */
+            bool load (const std::string& fileName) {
+                static_assert (std::is_trivially_copyable <T>::value, "use load() with a deserializer lambda");
+
+                FileMapping mapping (fileName);
+                const s_FileHeader* header = mapping.getHeader (FILE_TRIVIAL);
+                if (header == NULL)
+                    return false;
+
+                reset();
+                const char* address = mapping.getAddress();
+                const uint64_t* ids = reinterpret_cast <const uint64_t*> (address + sizeof (s_FileHeader));
+                const T* data = reinterpret_cast <const T*> (address + header-> dataOffset);
+
+                for (size_t i = 0; i < header-> numNodes; i++)
+                    emplaceTail (ids[i], data[i]);
+                return true;
+            }
+
+            // the lambda builds the node data (default constructed) from the bytes written by the serializer
+            bool load (const std::string& fileName, void (*lambda) (T*, const char*, size_t)) {
+                FileMapping mapping (fileName);
+                const s_FileHeader* header = mapping.getHeader (FILE_CUSTOM);
+                if (header == NULL)
+                    return false;
+
+                const char* address = mapping.getAddress();
+                const uint64_t* ids = reinterpret_cast <const uint64_t*> (address + sizeof (s_FileHeader));
+                const uint64_t* sizes = ids + header-> numNodes;
+                const char* data = address + header-> dataOffset;
+
+                // data sizes have to add up to the data section
+                size_t dataSize = 0;
+                for (size_t i = 0; i < header-> numNodes; i++) {
+                    if (sizes[i] > header-> dataSize - dataSize)
+                        return false;
+                    dataSize += sizes[i];
+                }
+
+                reset();
+                for (size_t i = 0; i < header-> numNodes; i++) {
+                    emplaceTail (ids[i]);
+                    lambda (& (m_tailNode-> data), data, sizes[i]);
+                    data += sizes[i];
+                }
+                return true;
+            }
+
+            inline MappedView mapFile (const std::string& fileName) const {
+                return MappedView (fileName);
+            }
+
+            // safe to call from any thread, returns the last published version of the list
+            inline Snapshot snapshot (void) const {
+                std::lock_guard <std::mutex> lock (m_versionMutex);
+                return Snapshot (m_publishedVersion);
+            }
+
+            inline iterator begin (void) {
+                return iterator (m_headNode, this);
+            }
+
+            inline iterator end (void) {
+                return iterator (NULL, this);
+            }
+
+            inline const_iterator begin (void) const {
+                return const_iterator (m_headNode, this);
+            }
+
+            inline const_iterator end (void) const {
+                return const_iterator (NULL, this);
+            }
+
+            inline const_iterator cbegin (void) const {
+                return begin();
+            }
+
+            inline const_iterator cend (void) const {
+                return end();
+            }
+
             /* list is displayed in the following format
              * list : 
              *      {                                   <L1>
@@ -35,6 +35,13 @@ namespace Memory {
                 else
                     assert (false);
             }
+
+            // use as the mgr dump lambda, to dump the stats of each list instance
+            static void dumpStats (Admin::NonTemplateBase* instance, std::ostream& ost) {
+                ListInstrumentation* c_list = dynamic_cast <ListInstrumentation*> (instance);
+                if (c_list != NULL)
+                    c_list-> dumpStats (ost);
+            }
     };
     ListMgr listMgr;
 }   // namespace Memory
@@ -0,0 +1,233 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef LIST_STATS_H
+#define LIST_STATS_H
+
+#include "../../../Admin/InstanceMgr.h"
+#include <atomic>
+#include <bit>
+
+/* stats are off by default for every list instance, unless compiled with LIST_STATS_ON defined (LIST_STATS itself is
+ * the macro that returns the stats)
+*/
+#ifdef LIST_STATS_ON
+    #define LIST_STATS_DEFAULT          true
+#else
+    #define LIST_STATS_DEFAULT          false
+#endif
+// scan lengths above 2^30 nodes all go into the last bucket
+#define LIST_SCAN_HISTOGRAM_SIZE        32
+
+namespace Collections {
+namespace Memory {
+    typedef struct ListStats {
+        size_t numAdds;
+        size_t numRemoves;
+        size_t numResets;
+        size_t numPeekSets;
+        size_t numSwaps;
+        // id lookups, and the total number of nodes visited by them
+        size_t numLookups;
+        size_t numNodesVisited;
+        /* log2 histogram of nodes visited per lookup, bucket 0 is 0 nodes (empty list), bucket 1 is 1 node, bucket 2 is
+         * 2-3 nodes, bucket 3 is 4-7 nodes and so on
+        */
+        size_t scanHistogram[LIST_SCAN_HISTOGRAM_SIZE];
+    }s_ListStats;
+
+    /* operation counters of a list instance. This is a non template base of the list so that the list mgr can get to the
+     * stats of every instance without knowing its data type. Counters are relaxed atomics, so lists with concurrent
+     * readers (cursors) are counted correctly too; when stats are disabled nothing is counted
+     *
+     * The counters are only allocated the first time stats are enabled (and kept after that, so the counts are still
+     * there once stats are disabled again). A list that never enables stats carries a single NULL pointer, and every
+     * add, remove and peek pays one NULL check
+    */
+    class ListInstrumentation {
+        private:
+            typedef struct Counters {
+                bool enabled;
+
+                std::atomic <size_t> numAdds;
+                std::atomic <size_t> numRemoves;
+                std::atomic <size_t> numResets;
+                std::atomic <size_t> numPeekSets;
+                std::atomic <size_t> numSwaps;
+                std::atomic <size_t> numLookups;
+                std::atomic <size_t> numNodesVisited;
+                std::atomic <size_t> scanHistogram[LIST_SCAN_HISTOGRAM_SIZE];
+            }s_Counters;
+
+            s_Counters* m_counters;
+
+            // returns NULL if stats are disabled
+            inline s_Counters* getCounters (void) {
+                return (m_counters != NULL && m_counters-> enabled) ? m_counters : NULL;
+            }
+
+            inline void count (std::atomic <size_t>& counter, size_t value = 1) {
+                counter.fetch_add (value, std::memory_order_relaxed);
+            }
+
+        protected:
+            inline void countAdd (void) {
+                if (s_Counters* counters = getCounters())
+                    count (counters-> numAdds);
+            }
+
+            inline void countRemove (void) {
+                if (s_Counters* counters = getCounters())
+                    count (counters-> numRemoves);
+            }
+
+            inline void countReset (void) {
+                if (s_Counters* counters = getCounters())
+                    count (counters-> numResets);
+            }
+
+            inline void countPeekSet (void) {
+                if (s_Counters* counters = getCounters())
+                    count (counters-> numPeekSets);
+            }
+
+            inline void countSwap (void) {
+                if (s_Counters* counters = getCounters())
+                    count (counters-> numSwaps);
+            }
+
+            void countLookup (size_t numNodesVisited) {
+                s_Counters* counters = getCounters();
+                if (counters == NULL)
+                    return;
+
+                count (counters-> numLookups);
+                count (counters-> numNodesVisited, numNodesVisited);
+
+                size_t bucket = std::min (static_cast <size_t> (std::bit_width (numNodesVisited)), 
+                                          static_cast <size_t> (LIST_SCAN_HISTOGRAM_SIZE - 1));
+                count (counters-> scanHistogram[bucket]);
+            }
+
+        public:
+            ListInstrumentation (void) {
+                m_counters = NULL;
+                if (LIST_STATS_DEFAULT)
+                    enableStats (true);
+            }
+
+            ~ListInstrumentation (void) {
+                delete m_counters;
+            }
+
+            // the counters are owned by the instance
+            ListInstrumentation (const ListInstrumentation& other) = delete;
+            ListInstrumentation& operator = (const ListInstrumentation& other) = delete;
+
+            // not thread safe, enable or disable stats before the list is shared
+            void enableStats (bool enable) {
+                if (enable == true && m_counters == NULL) {
+                    m_counters = new s_Counters;
+                    resetStats();
+                }
+
+                if (m_counters != NULL)
+                    m_counters-> enabled = enable;
+            }
+
+            inline bool isStatsEnabled (void) {
+                return getCounters() != NULL;
+            }
+
+            // all zeros if stats were never enabled
+            s_ListStats getStats (void) {
+                s_ListStats stats = { };
+                if (m_counters == NULL)
+                    return stats;
+
+                stats.numAdds = m_counters-> numAdds.load (std::memory_order_relaxed);
+                stats.numRemoves = m_counters-> numRemoves.load (std::memory_order_relaxed);
+                stats.numResets = m_counters-> numResets.load (std::memory_order_relaxed);
+                stats.numPeekSets = m_counters-> numPeekSets.load (std::memory_order_relaxed);
+                stats.numSwaps = m_counters-> numSwaps.load (std::memory_order_relaxed);
+                stats.numLookups = m_counters-> numLookups.load (std::memory_order_relaxed);
+                stats.numNodesVisited = m_counters-> numNodesVisited.load (std::memory_order_relaxed);
+
+                for (size_t i = 0; i < LIST_SCAN_HISTOGRAM_SIZE; i++)
+                    stats.scanHistogram[i] = m_counters-> scanHistogram[i].load (std::memory_order_relaxed);
+                return stats;
+            }
+
+            void resetStats (void) {
+                if (m_counters == NULL)
+                    return;
+
+                m_counters-> numAdds = 0;
+                m_counters-> numRemoves = 0;
+                m_counters-> numResets = 0;
+                m_counters-> numPeekSets = 0;
+                m_counters-> numSwaps = 0;
+                m_counters-> numLookups = 0;
+                m_counters-> numNodesVisited = 0;
+
+                for (auto& bucket : m_counters-> scanHistogram)
+                    bucket = 0;
+            }
+
+            /* stats are displayed in the following format, to fit in the list mgr dump
+             *                          stats enabled : ?               <L4>
+             *                          adds : ?
+             *                          removes : ?
+             *                          resets : ?
+             *                          peek sets : ?
+             *                          swaps : ?
+             *                          lookups : ?
+             *                          nodes visited : ?
+             *                          scan lengths : 
+             *                              [?, ?] : ?                  <L5>
+             *                              ...
+             *
+             * only the non empty buckets of the scan length histogram are displayed
+            */
+            void dumpStats (std::ostream& ost) {
+                s_ListStats stats = getStats();
+
+                ost << TAB_L4 << "stats enabled : "     << (isStatsEnabled() ? "true" : "false") << "\n";
+                ost << TAB_L4 << "adds : "              << stats.numAdds                        << "\n";
+                ost << TAB_L4 << "removes : "           << stats.numRemoves                     << "\n";
+                ost << TAB_L4 << "resets : "            << stats.numResets                      << "\n";
+                ost << TAB_L4 << "peek sets : "         << stats.numPeekSets                    << "\n";
+                ost << TAB_L4 << "swaps : "             << stats.numSwaps                       << "\n";
+                ost << TAB_L4 << "lookups : "           << stats.numLookups                     << "\n";
+                ost << TAB_L4 << "nodes visited : "     << stats.numNodesVisited                << "\n";
+
+                ost << TAB_L4 << "scan lengths : "      << "\n";
+                for (size_t i = 0; i < LIST_SCAN_HISTOGRAM_SIZE; i++) {
+                    if (stats.scanHistogram[i] == 0)
+                        continue;
+
+                    size_t low = (i == 0) ? 0 : (static_cast <size_t> (1) << (i - 1));
+                    size_t high = (i == 0) ? 0 : (static_cast <size_t> (1) << i) - 1;
+                    ost << TAB_L5 << "[" << low << ", ";
+                    // last bucket has no upper limit
+                    if (i == LIST_SCAN_HISTOGRAM_SIZE - 1)
+                        ost << "-";
+                    else
+                        ost << high;
+                    ost << "] : " << stats.scanHistogram[i] << "\n";
+                }
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // LIST_STATS_H
\ No newline at end of file
@@ -13,6 +13,12 @@
  */
 #include "../inc/List.h"
 #include "../../../Common/LibTest/inc/LibTest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#ifdef LIST_BENCHMARK
+#include <chrono>
+#endif
 
 using namespace Collections;
 
@@ -798,6 +804,1118 @@ LIB_TEST_CASE (28, "list as stack") {
     return Quality::Test::PASS;                                         
 }
 
+LIB_TEST_CASE (29, "sort list") {
+    auto myList = LIST_INIT (29, int);
+
+    std::pair <size_t, int> input[] = { { 0, 40 }, 
+                                        { 1, 10 },
+                                        { 2, 60 },
+                                        { 3, 30 },
+                                        { 4, 50 },
+                                        { 5, 20 } };
+    int output[] = { 10, 20, 30, 40, 50, 60 };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    // peek node should remain valid after the sort
+    myList-> LIST_PEEK_SET (2);
+    myList-> LIST_SORT;
+    myList-> LIST_DUMP;
+
+    if (myList-> LIST_PEEK_CURRENT-> data != 60)
+        return Quality::Test::FAIL;
+
+    // traverse forward
+    int i = 0;
+    myList-> LIST_PEEK_SET_HEAD;
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        if (myList-> LIST_PEEK_CURRENT-> data != output[i++])
+            return Quality::Test::FAIL;
+
+        myList-> LIST_PEEK_SET_NEXT;
+    }
+
+    // traverse backward to verify previous links
+    i = 5;
+    myList-> LIST_PEEK_SET_TAIL;
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        if (myList-> LIST_PEEK_CURRENT-> data != output[i--])
+            return Quality::Test::FAIL;
+
+        myList-> LIST_PEEK_SET_PREVIOUS;
+    }
+
+    if (myList-> LIST_SIZE != 6)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (29);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (30, "stable sort with custom comparator") {
+    typedef struct {
+        std::string name;
+        int rank;
+    }s_customType;
+
+    auto myList = LIST_INIT (30, s_customType);
+
+    std::pair <size_t, s_customType> input[] = { { 0, { "John",   2 } }, 
+                                                 { 1, { "Adams",  1 } },
+                                                 { 2, { "Mary",   2 } },
+                                                 { 3, { "Kate",   1 } },
+                                                 { 4, { "Steve",  0 } } };
+    // nodes with the same rank retain their relative order
+    size_t output[] = { 4, 1, 3, 0, 2 };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    auto lambda_compare = [](s_customType* dataA, s_customType* dataB) {
+                                return dataA-> rank < dataB-> rank;
+                            };
+    myList-> LIST_SORT_CUSTOM (lambda_compare);
+
+    int i = 0;
+    myList-> LIST_PEEK_SET_HEAD;
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        if (myList-> LIST_PEEK_CURRENT-> id != output[i++])
+            return Quality::Test::FAIL;
+
+        myList-> LIST_PEEK_SET_NEXT;
+    }
+
+    // sort empty list and list with 1 node
+    auto myList1 = LIST_INIT (31, int);
+    myList1-> LIST_SORT;
+    myList1-> LIST_ADD_HEAD (0, 10);
+    myList1-> LIST_SORT;
+
+    if (myList1-> LIST_PEEK_HEAD != myList1-> LIST_PEEK_TAIL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (30);
+    LIST_CLOSE (31);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (31, "parallel sort large list") {
+    auto myList = LIST_INIT (31, int);
+
+    size_t numNodes = 100000;
+    // linear congruential generator for repeatable input
+    unsigned int seed = 7;
+    for (size_t i = 0; i < numNodes; i++) {
+        seed = seed * 1103515245 + 12345;
+        myList-> LIST_ADD_TAIL (i, (seed >> 16) % 1000);
+    }
+
+    auto lambda_compare = [](int* dataA, int* dataB) {
+                                return *dataA < *dataB;
+                            };
+    myList-> LIST_SORT_PARALLEL_CUSTOM (4, lambda_compare);
+
+    if (myList-> LIST_SIZE != numNodes)
+        return Quality::Test::FAIL;
+
+    // ascending data, and ascending ids for equal data (stable)
+    size_t count = 1;
+    myList-> LIST_PEEK_SET_HEAD;
+    auto previousNode = myList-> LIST_PEEK_CURRENT;
+    myList-> LIST_PEEK_SET_NEXT;
+
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        auto currentNode = myList-> LIST_PEEK_CURRENT;
+        if (currentNode-> previous != previousNode)
+            return Quality::Test::FAIL;
+
+        if (currentNode-> data < previousNode-> data)
+            return Quality::Test::FAIL;
+
+        if (currentNode-> data == previousNode-> data && currentNode-> id < previousNode-> id)
+            return Quality::Test::FAIL;
+
+        previousNode = currentNode;
+        myList-> LIST_PEEK_SET_NEXT;
+        count++;
+    }
+
+    if (count != numNodes || myList-> LIST_PEEK_TAIL != previousNode)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (31);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (32, "insert sorted") {
+    auto myList = LIST_INIT (32, int);
+
+    std::pair <size_t, int> input[] = { { 0, 30 }, 
+                                        { 1, 10 },
+                                        { 2, 50 },
+                                        { 3, 30 },
+                                        { 4, 20 },
+                                        { 5, 60 } };
+    // node with id 3 is inserted after node with id 0 since they are equal
+    size_t output[] = { 1, 4, 0, 3, 2, 5 };
+
+    for (auto i : input)
+        myList-> LIST_INSERT_SORTED (i.first, i.second);
+    myList-> LIST_DUMP;
+
+    int i = 0;
+    myList-> LIST_PEEK_SET_HEAD;
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        if (myList-> LIST_PEEK_CURRENT-> id != output[i++])
+            return Quality::Test::FAIL;
+
+        myList-> LIST_PEEK_SET_NEXT;
+    }
+
+    if (myList-> LIST_PEEK_HEAD-> data != 10 || myList-> LIST_PEEK_TAIL-> data != 60)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (32);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (33, "independent cursors") {
+    auto myList = LIST_INIT (33, int);
+
+    std::pair <size_t, int> input[] = { { 0, 10 }, 
+                                        { 1, 20 },
+                                        { 2, 30 },
+                                        { 3, 40 } };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    // list peek position
+    myList-> LIST_PEEK_SET (1);
+
+    // cursors start at the peek position
+    auto myCursor0 = myList-> LIST_CURSOR;
+    auto myCursor1 = myList-> LIST_CURSOR;
+
+    myCursor0.LIST_PEEK_SET_HEAD;
+    myCursor1.LIST_PEEK_SET_TAIL;
+
+    // walk in opposite directions
+    for (int i = 0; i < 4; i++) {
+        if (myCursor0.LIST_PEEK_CURRENT-> data != input[i].second ||
+            myCursor1.LIST_PEEK_CURRENT-> data != input[3 - i].second)
+            return Quality::Test::FAIL;
+
+        myCursor0.LIST_PEEK_SET_NEXT;
+        myCursor1.LIST_PEEK_SET_PREVIOUS;
+    }
+
+    if (myCursor0.LIST_PEEK_CURRENT != NULL || myCursor1.LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    // list peek position is unaffected
+    if (myList-> LIST_PEEK_CURRENT-> id != 1)
+        return Quality::Test::FAIL;
+
+    // cursor at invalid id
+    myCursor0.LIST_PEEK_SET (100);
+    if (myCursor0.LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (33);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (34, "nested traversal using cursors") {
+    auto myList = LIST_INIT (34, int);
+
+    std::pair <size_t, int> input[] = { { 0, 10 }, 
+                                        { 1, 20 },
+                                        { 2, 30 },
+                                        { 3, 40 } };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    // count pairs (a, b) where a comes before b in the list and a + b > 50
+    size_t numPairs = 0;
+    auto outerCursor = myList-> LIST_CURSOR;
+    outerCursor.LIST_PEEK_SET_HEAD;
+
+    while (outerCursor.LIST_PEEK_CURRENT != NULL) {
+        auto innerCursor = outerCursor;
+        innerCursor.LIST_PEEK_SET_NEXT;
+
+        while (innerCursor.LIST_PEEK_CURRENT != NULL) {
+            if (outerCursor.LIST_PEEK_CURRENT-> data + innerCursor.LIST_PEEK_CURRENT-> data > 50)
+                numPairs++;
+
+            innerCursor.LIST_PEEK_SET_NEXT;
+        }
+        outerCursor.LIST_PEEK_SET_NEXT;
+    }
+
+    // (20, 40), (30, 40)
+    if (numPairs != 2)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (34);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (35, "add/remove at cursor") {
+    auto myList = LIST_INIT (35, int);
+
+    std::pair <size_t, int> input[] = { { 0, 10 }, 
+                                        { 1, 20 },
+                                        { 2, 30 } };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    auto myCursor = myList-> LIST_CURSOR;
+    myCursor.LIST_PEEK_SET_HEAD;
+
+    // new head and new tail through cursors
+    myCursor.LIST_ADD_BEFORE (3, 5);
+    myCursor.LIST_PEEK_SET_TAIL;
+    myCursor.LIST_ADD_AFTER (4, 35);
+    myList-> LIST_DUMP;
+
+    if (myList-> LIST_PEEK_HEAD-> data != 5 || myList-> LIST_PEEK_TAIL-> data != 35)
+        return Quality::Test::FAIL;
+
+    // remove node that is also the list peek node
+    myList-> LIST_PEEK_SET (1);
+    myCursor.LIST_PEEK_SET (1);
+    if (myCursor.LIST_REMOVE != true)
+        return Quality::Test::FAIL;
+
+    if (myCursor.LIST_PEEK_CURRENT != NULL || myList-> LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    // cursor at NULL
+    if (myCursor.LIST_REMOVE    != false ||
+        myCursor.LIST_ADD_AFTER (5, 50) != false ||
+        myCursor.LIST_ADD_BEFORE (5, 50) != false)
+        return Quality::Test::FAIL;
+
+    int output[] = { 5, 10, 30, 35 };
+    myCursor.LIST_PEEK_SET_HEAD;
+    for (auto i : output) {
+        if (myCursor.LIST_PEEK_CURRENT-> data != i)
+            return Quality::Test::FAIL;
+        myCursor.LIST_PEEK_SET_NEXT;
+    }
+
+    if (myList-> LIST_SIZE != 4)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (35);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (36, "concurrent readers using cursors") {
+    auto myList = LIST_INIT (36, int);
+
+    size_t numNodes = 10000;
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i, 1);
+
+    // each reader walks the complete list using its own cursor
+    size_t sums[4] = { 0, 0, 0, 0 };
+    std::vector <std::thread> readers;
+    for (size_t r = 0; r < 4; r++) {
+        readers.emplace_back ([myList, &sums, r]() {
+            auto myCursor = myList-> LIST_CURSOR;
+            // odd readers walk backwards
+            bool forward = (r % 2 == 0);
+            if (forward)
+                myCursor.LIST_PEEK_SET_HEAD;
+            else
+                myCursor.LIST_PEEK_SET_TAIL;
+
+            while (myCursor.LIST_PEEK_CURRENT != NULL) {
+                sums[r] += myCursor.LIST_PEEK_CURRENT-> data;
+
+                if (forward)
+                    myCursor.LIST_PEEK_SET_NEXT;
+                else
+                    myCursor.LIST_PEEK_SET_PREVIOUS;
+            }
+        });
+    }
+
+    for (auto& reader : readers)
+        reader.join();
+
+    for (auto sum : sums) {
+        if (sum != numNodes)
+            return Quality::Test::FAIL;
+    }
+
+    LIST_CLOSE (36);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (37, "range based for loop and std algorithms") {
+    static_assert (std::ranges::bidirectional_range <Memory::List <int>>);
+    static_assert (std::bidirectional_iterator <Memory::List <int>::const_iterator>);
+
+    auto myList = LIST_INIT (37, int);
+
+    std::pair <size_t, int> input[] = { { 0, 10 }, 
+                                        { 1, 20 },
+                                        { 2, 30 },
+                                        { 3, 40 } };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    // update data through the iterator
+    for (auto& data : *myList)
+        data += 1;
+
+    int sum = std::accumulate (myList-> begin(), myList-> end(), 0);
+    if (sum != 104)
+        return Quality::Test::FAIL;
+
+    auto iter = std::find (myList-> begin(), myList-> end(), 31);
+    if (iter == myList-> end() || iter.getId() != 2)
+        return Quality::Test::FAIL;
+
+    if (std::count_if (myList-> begin(), myList-> end(), [](int data) { return data > 15; }) != 3)
+        return Quality::Test::FAIL;
+
+    // traverse backward using ranges
+    int i = 3;
+    for (auto data : *myList | std::views::reverse) {
+        if (data != input[i--].second + 1)
+            return Quality::Test::FAIL;
+    }
+
+    LIST_CLOSE (37);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (38, "const iteration") {
+    auto myList = LIST_INIT (38, int);
+
+    // empty list
+    if (myList-> begin() != myList-> end())
+        return Quality::Test::FAIL;
+
+    std::pair <size_t, int> input[] = { { 0, 10 }, 
+                                        { 1, 20 },
+                                        { 2, 30 } };
+
+    for (auto i : input)
+        myList-> LIST_ADD_TAIL (i.first, i.second);
+
+    const Memory::List <int>& myConstList = *myList;
+
+    int i = 0;
+    for (auto iter = myConstList.begin(); iter != myConstList.end(); iter++) {
+        if (*iter != input[i].second || iter.getId() != input[i].first)
+            return Quality::Test::FAIL;
+        i++;
+    }
+
+    // decrementing end() moves to the tail node
+    Memory::List <int>::const_iterator iter = myList-> end();
+    iter--;
+    if (*iter != 30 || iter.getId() != 2)
+        return Quality::Test::FAIL;
+
+    if (std::ranges::distance (myConstList) != 3)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (38);
+    return Quality::Test::PASS;
+}
+
+// counts the number of copies and moves of the node data
+struct Payload {
+    static size_t numCopies;
+    static size_t numMoves;
+    std::string value;
+
+    Payload (void) = default;
+    Payload (size_t count, char c) : value (count, c) {}
+
+    Payload (const Payload& other) : value (other.value) { 
+        numCopies++; 
+    }
+    Payload (Payload&& other) : value (std::move (other.value)) { 
+        numMoves++; 
+    }
+    Payload& operator = (const Payload& other) { 
+        value = other.value;  numCopies++;  
+        return *this; 
+    }
+    Payload& operator = (Payload&& other) { 
+        value = std::move (other.value);  numMoves++;  
+        return *this; 
+    }
+};
+size_t Payload::numCopies = 0;
+size_t Payload::numMoves = 0;
+
+LIB_TEST_CASE (39, "emplace and move into list") {
+    auto myList = LIST_INIT (39, Payload);
+    Payload::numCopies = 0;
+    Payload::numMoves = 0;
+
+    // constructed in place, no copies or moves
+    myList-> LIST_EMPLACE_TAIL (1, 3, 'b');
+    myList-> LIST_EMPLACE_HEAD (0, 3, 'a');
+    myList-> LIST_PEEK_SET (1);
+    myList-> LIST_EMPLACE_AFTER (3, 3, 'd');
+    myList-> LIST_PEEK_SET (3);
+    myList-> LIST_EMPLACE_BEFORE (2, 3, 'c');
+
+    if (Payload::numCopies != 0 || Payload::numMoves != 0)
+        return Quality::Test::FAIL;
+
+    // moved in
+    Payload payload (3, 'e');
+    myList-> LIST_ADD_TAIL (4, std::move (payload));
+    myList-> LIST_ADD_HEAD (5, Payload (3, 'f'));
+    if (Payload::numCopies != 0 || Payload::numMoves != 2)
+        return Quality::Test::FAIL;
+
+    // copied in
+    Payload other (3, 'g');
+    myList-> LIST_ADD_TAIL (6, other);
+    if (Payload::numCopies != 1 || other.value != "ggg")
+        return Quality::Test::FAIL;
+
+    // { 5, fff } { 0, aaa } { 1, bbb } { 2, ccc } { 3, ddd } { 4, eee } { 6, ggg }
+    std::string output[] = { "fff", "aaa", "bbb", "ccc", "ddd", "eee", "ggg" };
+    size_t i = 0;
+    for (auto& data : *myList) {
+        if (data.value != output[i++])
+            return Quality::Test::FAIL;
+    }
+    myList-> LIST_DUMP_CUSTOM ([](Payload* data, std::ostream& ost) {
+        ost << data-> value;
+    });
+
+    LIST_CLOSE (39);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (40, "pop from list") {
+    auto myList = LIST_INIT (40, Payload);
+
+    for (size_t i = 0; i < 4; i++)
+        myList-> LIST_EMPLACE_TAIL (i, 100, static_cast <char> ('a' + i));
+
+    Payload::numCopies = 0;
+    Payload::numMoves = 0;
+
+    size_t id;
+    Payload data;
+    if (myList-> LIST_POP_HEAD (id, data) == false || id != 0 || data.value != std::string (100, 'a'))
+        return Quality::Test::FAIL;
+
+    if (myList-> LIST_POP_TAIL (id, data) == false || id != 3 || data.value != std::string (100, 'd'))
+        return Quality::Test::FAIL;
+
+    myList-> LIST_PEEK_SET (2);
+    if (myList-> LIST_POP (id, data) == false || id != 2 || myList-> LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    // data is moved out, never copied
+    if (Payload::numCopies != 0 || Payload::numMoves != 3 || myList-> LIST_SIZE != 1)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_POP_HEAD (id, data);
+    // empty list
+    if (myList-> LIST_POP_HEAD (id, data) == true || myList-> LIST_POP_TAIL (id, data) == true)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (40);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (41, "snapshots") {
+    auto myList = LIST_INIT (41, int);
+
+    // nothing published yet
+    auto snapshot0 = myList-> LIST_SNAPSHOT;
+    if (snapshot0.LIST_SIZE != 0 || snapshot0.LIST_SNAPSHOT_VERSION != 0)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_ADD_TAIL (0, 10);
+    myList-> LIST_ADD_TAIL (1, 20);
+    myList-> LIST_PUBLISH;
+    auto snapshot1 = myList-> LIST_SNAPSHOT;
+
+    // snapshot is not affected by changes made after it was published
+    myList-> LIST_REMOVE_HEAD;
+    myList-> LIST_PEEK_HEAD-> data = 21;
+    myList-> LIST_ADD_TAIL (2, 30);
+
+    if (snapshot1.LIST_SIZE != 2 || snapshot1.LIST_SNAPSHOT_VERSION != 1)
+        return Quality::Test::FAIL;
+
+    std::pair <size_t, int> output1[] = { { 0, 10 }, { 1, 20 } };
+    size_t i = 0;
+    for (auto const& [id, data] : snapshot1) {
+        if (id != output1[i].first || data != output1[i].second)
+            return Quality::Test::FAIL;
+        i++;
+    }
+
+    myList-> LIST_PUBLISH;
+    auto snapshot2 = myList-> LIST_SNAPSHOT;
+    std::pair <size_t, int> output2[] = { { 1, 21 }, { 2, 30 } };
+    if (snapshot2.LIST_SNAPSHOT_VERSION != 2 || !std::equal (snapshot2.begin(), snapshot2.end(), output2))
+        return Quality::Test::FAIL;
+
+    // snapshots outlive the list
+    LIST_CLOSE (41);
+    if (snapshot1.LIST_SIZE != 2 || snapshot2.begin()-> second != 21)
+        return Quality::Test::FAIL;
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (42, "concurrent readers using snapshots") {
+    auto myList = LIST_INIT (42, size_t);
+
+    size_t numReaders = 4;
+    size_t numBatches = 200;
+    std::atomic <bool> done = false;
+    std::atomic <bool> consistent = true;
+
+    /* the writer keeps the list as { i, i * 2 } for i in [first, first + 100), and publishes after every batch; each
+     * snapshot is expected to hold exactly one such run
+    */
+    std::vector <std::thread> readers;
+    for (size_t t = 0; t < numReaders; t++) {
+        readers.push_back (std::thread ([&]() {
+            size_t lastVersion = 0;
+            while (!done) {
+                auto mySnapshot = myList-> LIST_SNAPSHOT;
+                if (mySnapshot.LIST_SNAPSHOT_VERSION < lastVersion)
+                    consistent = false;
+                lastVersion = mySnapshot.LIST_SNAPSHOT_VERSION;
+
+                if (lastVersion == 0)
+                    continue;
+
+                size_t expectedId = mySnapshot.begin()-> first;
+                for (auto const& [id, data] : mySnapshot) {
+                    if (id != expectedId || data != id * 2)
+                        consistent = false;
+                    expectedId++;
+                }
+                if (mySnapshot.LIST_SIZE != 100)
+                    consistent = false;
+            }
+        }));
+    }
+
+    for (size_t i = 0; i < 100; i++)
+        myList-> LIST_ADD_TAIL (i, i * 2);
+    myList-> LIST_PUBLISH;
+
+    for (size_t batch = 1; batch < numBatches; batch++) {
+        // slide the run forward by 10 nodes
+        for (size_t i = 0; i < 10; i++) {
+            size_t id = myList-> LIST_PEEK_TAIL-> id + 1;
+            myList-> LIST_REMOVE_HEAD;
+            myList-> LIST_ADD_TAIL (id, id * 2);
+        }
+        myList-> LIST_PUBLISH;
+    }
+
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+
+    if (!consistent || myList-> LIST_SNAPSHOT.LIST_SNAPSHOT_VERSION != numBatches)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (42);
+    return Quality::Test::PASS;
+}
+
+struct Record {
+    size_t key;
+    double value;
+    char tag[4];
+};
+
+LIB_TEST_CASE (43, "binary save and load") {
+    auto myList = LIST_INIT (43, Record);
+    auto myLoadedList = LIST_INIT (44, Record);
+    std::string fileName = "./Build/Save/List/Test_43.bin";
+
+    size_t numNodes = 10000;
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i * 3, (Record { i, i * 0.5, "abc" }));
+
+    if (myList-> LIST_SAVE (fileName) == false)
+        return Quality::Test::FAIL;
+
+    if (myLoadedList-> LIST_LOAD (fileName) == false)
+        return Quality::Test::FAIL;
+
+    if (myLoadedList-> LIST_SIZE != numNodes || myLoadedList-> LIST_PEEK_TAIL-> id != (numNodes - 1) * 3)
+        return Quality::Test::FAIL;
+
+    auto iterA = myList-> begin();
+    for (auto iterB = myLoadedList-> begin(); iterB != myLoadedList-> end(); ++iterA, ++iterB) {
+        if (iterA.getId() != iterB.getId() || iterA-> key != iterB-> key || iterA-> value != iterB-> value || 
+            std::string (iterB-> tag) != "abc")
+            return Quality::Test::FAIL;
+    }
+
+    // invalid files leave the list unchanged
+    if (myLoadedList-> LIST_LOAD ("./Build/Save/List/Test_43_missing.bin") == true || 
+        myLoadedList-> LIST_SIZE != numNodes)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (43);
+    LIST_CLOSE (44);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (44, "binary save and load with serializer") {
+    auto myList = LIST_INIT (44, std::string);
+    auto myLoadedList = LIST_INIT (45, std::string);
+    std::string fileName = "./Build/Save/List/Test_44.bin";
+
+    for (size_t i = 0; i < 1000; i++)
+        myList-> LIST_ADD_TAIL (i, std::string (i % 37, static_cast <char> ('a' + i % 26)));
+
+    myList-> LIST_SAVE_CUSTOM (fileName, [](std::string* data, std::string& bytes) {
+        bytes.append (*data);
+    });
+
+    // a file saved with a serializer is not a valid file for the trivially copyable format
+    auto myIntList = LIST_INIT (46, int);
+    if (myIntList-> LIST_LOAD (fileName) == true)
+        return Quality::Test::FAIL;
+
+    bool loaded = myLoadedList-> LIST_LOAD_CUSTOM (fileName, [](std::string* data, const char* bytes, size_t numBytes) {
+        data-> assign (bytes, numBytes);
+    });
+    if (loaded == false || myLoadedList-> LIST_SIZE != 1000)
+        return Quality::Test::FAIL;
+
+    if (!std::equal (myList-> begin(), myList-> end(), myLoadedList-> begin()))
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (44);
+    LIST_CLOSE (45);
+    LIST_CLOSE (46);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (45, "mapped view of saved list") {
+    auto myList = LIST_INIT (45, double);
+    std::string fileName = "./Build/Save/List/Test_45.bin";
+
+    for (size_t i = 0; i < 100; i++)
+        myList-> LIST_ADD_HEAD (i, i * 1.5);
+    myList-> LIST_SAVE (fileName);
+
+    auto myView = myList-> LIST_MAP_FILE (fileName);
+    if (myView.isValid() == false || myView.getSize() != 100)
+        return Quality::Test::FAIL;
+
+    // head was added last
+    if (myView.getId (0) != 99 || myView.getData (0) != 99 * 1.5)
+        return Quality::Test::FAIL;
+
+    if (std::accumulate (myView.begin(), myView.end(), 0.0) != 1.5 * 4950)
+        return Quality::Test::FAIL;
+
+    // data type size does not match
+    auto myIntView = LIST_INIT (46, int)-> LIST_MAP_FILE (fileName);
+    if (myIntView.isValid() == true || myIntView.getSize() != 0)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (45);
+    LIST_CLOSE (46);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (46, "find, find if and count if") {
+    auto myList = LIST_INIT (46, int);
+
+    // { 0, 0 } { 1, 10 } ... { 9, 90 }
+    for (int i = 0; i < 10; i++)
+        myList-> LIST_ADD_TAIL (i, i * 10);
+
+    auto iter = myList-> LIST_FIND (40);
+    if (iter == myList-> end() || iter.getId() != 4)
+        return Quality::Test::FAIL;
+
+    if (myList-> LIST_FIND (45) != myList-> end())
+        return Quality::Test::FAIL;
+
+    iter = myList-> LIST_FIND_IF ([](int* data) { return *data > 55; });
+    if (iter == myList-> end() || *iter != 60)
+        return Quality::Test::FAIL;
+
+    if (myList-> LIST_COUNT_IF ([](int* data) { return *data % 20 == 0; }) != 5)
+        return Quality::Test::FAIL;
+
+    // peek position is left unchanged
+    if (myList-> LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (46);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (47, "remove if") {
+    auto myList = LIST_INIT (47, int);
+
+    int input[] = { 1, 2, 4, 3, 6, 8, 5, 7, 10 };
+    for (size_t i = 0; i < 9; i++)
+        myList-> LIST_ADD_TAIL (i, input[i]);
+
+    // peek at a node that is removed
+    myList-> LIST_PEEK_SET (2);
+    size_t numRemoved = myList-> LIST_REMOVE_IF ([](int* data) { return *data % 2 == 0; });
+    myList-> LIST_DUMP;
+
+    if (numRemoved != 5 || myList-> LIST_SIZE != 4 || myList-> LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    // { 0, 1 } { 3, 3 } { 6, 5 } { 7, 7 }
+    int output[] = { 1, 3, 5, 7 };
+    if (!std::equal (myList-> begin(), myList-> end(), output))
+        return Quality::Test::FAIL;
+
+    // backward links are intact
+    if (myList-> LIST_PEEK_TAIL-> previous-> data != 5 || myList-> LIST_PEEK_HEAD-> previous != NULL)
+        return Quality::Test::FAIL;
+
+    // remove all
+    if (myList-> LIST_REMOVE_IF ([](int*) { return true; }) != 4 || myList-> LIST_PEEK_HEAD != NULL || 
+        myList-> LIST_PEEK_TAIL != NULL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (47);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (48, "node memory is reused") {
+    auto myList = LIST_INIT (48, std::string);
+
+    for (size_t i = 0; i < 100; i++)
+        myList-> LIST_ADD_TAIL (i, std::to_string (i));
+
+    // a removed node's memory is handed out to the next new node
+    myList-> LIST_PEEK_SET (50);
+    auto removedNode = myList-> LIST_PEEK_CURRENT;
+    myList-> LIST_REMOVE;
+    myList-> LIST_ADD_HEAD (100, "100");
+
+    if (myList-> LIST_PEEK_HEAD != removedNode || myList-> LIST_PEEK_HEAD-> data != "100")
+        return Quality::Test::FAIL;
+
+    // list is usable after a reset
+    myList-> LIST_RESET;
+    myList-> LIST_ADD_TAIL (0, "0");
+    if (myList-> LIST_SIZE != 1 || myList-> LIST_PEEK_HEAD-> data != "0")
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (48);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (49, "bulk reset and close") {
+    size_t numNodes = 10000;
+
+    auto myList = LIST_INIT (49, size_t);
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i, i);
+
+    myList-> LIST_RESET;
+
+    if (myList-> LIST_SIZE != 0 || myList-> LIST_PEEK_HEAD != NULL || myList-> begin() != myList-> end())
+        return Quality::Test::FAIL;
+
+    // data with a destructor is still destroyed on close
+    auto myStringList = LIST_INIT (50, std::string);
+    for (size_t i = 0; i < 1000; i++)
+        myStringList-> LIST_ADD_TAIL (i, std::string (64, 'a'));
+    LIST_CLOSE (50);
+
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i, i);
+    LIST_CLOSE (49);
+    return Quality::Test::PASS;
+}
+
+// countIf against a manual peek loop over a list whose nodes have been relinked out of allocation order (see test 55)
+LIB_TEST_CASE (50, "count if over scattered nodes") {
+    auto myList = LIST_INIT (50, size_t);
+    size_t numNodes = 5000;
+
+    std::mt19937_64 generator (50);
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i, generator());
+    // relinking the nodes in data order scatters them across the node slabs
+    myList-> LIST_SORT;
+
+    auto predicate = [](size_t* data) { 
+        return *data % 3 == 0; 
+    };
+
+    size_t count = 0;
+    myList-> LIST_PEEK_SET_HEAD;
+    while (myList-> LIST_PEEK_CURRENT != NULL) {
+        count += predicate (& (myList-> LIST_PEEK_CURRENT-> data)) ? 1 : 0;
+        myList-> LIST_PEEK_SET_NEXT;
+    }
+
+    if (count == 0 || myList-> LIST_COUNT_IF (predicate) != count)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (50);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (51, "operation counters") {
+    auto myList = LIST_INIT (51, int);
+
+    // off by default
+    myList-> LIST_ADD_TAIL (0, 0);
+    if (myList-> LIST_STATS.numAdds != 0)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_STATS_ENABLE;
+    for (int i = 1; i < 100; i++)
+        myList-> LIST_ADD_TAIL (i, i);
+
+    // visits 1, 10 and 100 nodes (not found)
+    myList-> LIST_PEEK_SET (0);
+    myList-> LIST_PEEK_SET (9);
+    myList-> LIST_PEEK_SET (100);
+
+    auto myCursor = myList-> LIST_CURSOR;
+    // visits 64 nodes
+    myCursor.LIST_PEEK_SET (63);
+    myCursor.LIST_REMOVE;
+    myList-> LIST_SWAP (1, 2);
+
+    Memory::s_ListStats stats = myList-> LIST_STATS;
+    if (stats.numAdds != 99 || stats.numRemoves != 1 || stats.numPeekSets != 4 || stats.numSwaps != 1)
+        return Quality::Test::FAIL;
+
+    // 4 peek sets and 2 lookups for the swap (2 and 3 nodes)
+    if (stats.numLookups != 6 || stats.numNodesVisited != 1 + 10 + 100 + 64 + 2 + 3)
+        return Quality::Test::FAIL;
+
+    // [1] : 1, [2, 3] : 2 and 3, [8, 15] : 10, [64, 127] : 64 and 100
+    if (stats.scanHistogram[1] != 1 || stats.scanHistogram[2] != 2 || stats.scanHistogram[4] != 1 || 
+        stats.scanHistogram[7] != 2)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_RESET;
+    myList-> LIST_STATS_DISABLE;
+    myList-> LIST_ADD_TAIL (0, 0);
+    if (myList-> LIST_STATS.numResets != 1 || myList-> LIST_STATS.numAdds != 99)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_STATS_RESET;
+    if (myList-> LIST_STATS.numAdds != 0 || myList-> LIST_STATS.scanHistogram[7] != 0)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (51);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (52, "mgr stats dump") {
+    auto myList0 = LIST_INIT (0, int);
+    auto myList1 = LIST_INIT (1, std::string);
+
+    myList1-> LIST_STATS_ENABLE;
+    for (size_t i = 0; i < 1000; i++) {
+        myList0-> LIST_ADD_TAIL (i, static_cast <int> (i));
+        myList1-> LIST_ADD_TAIL (i, std::to_string (i));
+    }
+
+    // a scan heavy instance
+    for (size_t i = 0; i < 1000; i += 10)
+        myList1-> LIST_PEEK_SET (i);
+
+    LIST_MGR_DUMP_STATS;
+    LIST_CLOSE_ALL;
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (53, "batch insert at peek position") {
+    auto myList = LIST_INIT (53, std::string);
+
+    // no peek position
+    std::vector <std::pair <size_t, std::string>> batch = { { 1, "b" }, { 2, "c" } };
+    if (myList-> LIST_INSERT_AFTER (batch) == true)
+        return Quality::Test::FAIL;
+
+    myList-> LIST_ADD_HEAD (0, "a");
+    myList-> LIST_ADD_TAIL (9, "z");
+
+    // { 0, a } { 1, b } { 2, c } { 9, z }
+    myList-> LIST_PEEK_SET_HEAD;
+    myList-> LIST_INSERT_AFTER (batch);
+    // batch is copied from, moved from if passed as an rvalue
+    if (batch[0].second != "b")
+        return Quality::Test::FAIL;
+
+    // { 0, a } { 1, b } { 2, c } { 3, d } { 4, e } { 9, z }
+    myList-> LIST_PEEK_SET_TAIL;
+    myList-> LIST_INSERT_BEFORE ((std::vector <std::pair <size_t, std::string>> { { 3, "d" }, { 4, "e" } }));
+
+    // { 0, a } { 1, b } { 2, c } { 3, d } { 4, e } { 9, z } { 0, a } { 1, b } ... from a snapshot of the list itself
+    myList-> LIST_PUBLISH;
+    myList-> LIST_PEEK_SET_TAIL;
+    myList-> LIST_INSERT_AFTER (myList-> LIST_SNAPSHOT);
+
+    // empty range
+    myList-> LIST_PEEK_SET_HEAD;
+    if (myList-> LIST_INSERT_BEFORE ((std::vector <std::pair <size_t, std::string>> {})) == false)
+        return Quality::Test::FAIL;
+
+    std::string output = "abcdezabcdez";
+    if (myList-> LIST_SIZE != 12 || std::accumulate (myList-> begin(), myList-> end(), std::string()) != output)
+        return Quality::Test::FAIL;
+
+    // backward links
+    std::string reversed;
+    for (auto iter = myList-> end(); iter != myList-> begin();)
+        reversed += *(--iter);
+    if (reversed != std::string (output.rbegin(), output.rend()) || myList-> LIST_PEEK_HEAD-> previous != NULL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (53);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (54, "erase range between cursors") {
+    auto myList = LIST_INIT (54, int);
+
+    for (int i = 0; i < 10; i++)
+        myList-> LIST_ADD_TAIL (i, i);
+
+    auto firstCursor = myList-> LIST_CURSOR;
+    auto lastCursor = myList-> LIST_CURSOR;
+    // cursors not at valid nodes
+    if (myList-> LIST_ERASE_RANGE (firstCursor, lastCursor) != 0)
+        return Quality::Test::FAIL;
+
+    // { 0 } { 1 } { 7 } { 8 } { 9 }
+    firstCursor.LIST_PEEK_SET (2);
+    lastCursor.LIST_PEEK_SET (6);
+    myList-> LIST_PEEK_SET (4);
+    if (myList-> LIST_ERASE_RANGE (firstCursor, lastCursor) != 5 || myList-> LIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    int output[] = { 0, 1, 7, 8, 9 };
+    if (myList-> LIST_SIZE != 5 || !std::equal (myList-> begin(), myList-> end(), output))
+        return Quality::Test::FAIL;
+
+    // reversed cursors, list is not updated
+    firstCursor.LIST_PEEK_SET (8);
+    lastCursor.LIST_PEEK_SET (1);
+    if (myList-> LIST_ERASE_RANGE (firstCursor, lastCursor) != 0 || myList-> LIST_SIZE != 5 || 
+        !std::equal (myList-> begin(), myList-> end(), output))
+        return Quality::Test::FAIL;
+
+    // cursor from another list, neither list is updated
+    auto myOtherList = LIST_INIT (55, int);
+    myOtherList-> LIST_ADD_TAIL (7, 7);
+    auto otherCursor = myOtherList-> LIST_CURSOR;
+    otherCursor.LIST_PEEK_SET_HEAD;
+    firstCursor.LIST_PEEK_SET (1);
+    if (myList-> LIST_ERASE_RANGE (firstCursor, otherCursor) != 0 || 
+        myList-> LIST_ERASE_RANGE (otherCursor, otherCursor) != 0 || myList-> LIST_SIZE != 5 || 
+        !std::equal (myList-> begin(), myList-> end(), output) || myOtherList-> LIST_SIZE != 1)
+        return Quality::Test::FAIL;
+    LIST_CLOSE (55);
+
+    // { 8 } { 9 }, span at head
+    firstCursor.LIST_PEEK_SET_HEAD;
+    lastCursor.LIST_PEEK_SET (7);
+    myList-> LIST_ERASE_RANGE (firstCursor, lastCursor);
+    if (myList-> LIST_PEEK_HEAD-> data != 8 || myList-> LIST_PEEK_HEAD-> previous != NULL)
+        return Quality::Test::FAIL;
+
+    // whole list
+    firstCursor.LIST_PEEK_SET_HEAD;
+    lastCursor.LIST_PEEK_SET_TAIL;
+    if (myList-> LIST_ERASE_RANGE (firstCursor, lastCursor) != 2 || myList-> LIST_SIZE != 0 || 
+        myList-> LIST_PEEK_HEAD != NULL || myList-> LIST_PEEK_TAIL != NULL)
+        return Quality::Test::FAIL;
+
+    LIST_CLOSE (54);
+    return Quality::Test::PASS;
+}
+
+#ifdef LIST_BENCHMARK
+/* opt-in benchmark, not part of the default run. Build the sample with optimizations and the flag, for example
+ *      make List CXXFLAGS="-std=c++20 -O2 -pthread -DLIST_BENCHMARK"
+ *
+ * a scan is a chain of dependent loads, so its cost depends on where the nodes are. This times countIf and a manual peek
+ * loop over a list still in slab (allocation) order, and again after a sort has relinked the nodes in random order. Set
+ * LIST_BENCHMARK_NODES so that the nodes take well above the size of the last level cache on the target machine
+*/
+#ifndef LIST_BENCHMARK_NODES
+#define LIST_BENCHMARK_NODES            16000000
+#endif
+LIB_TEST_CASE (55, "scan benchmark") {
+    auto myList = LIST_INIT (55, size_t);
+    size_t numNodes = LIST_BENCHMARK_NODES;
+
+    std::mt19937_64 generator (55);
+    for (size_t i = 0; i < numNodes; i++)
+        myList-> LIST_ADD_TAIL (i, generator());
+
+    auto predicate = [](size_t* data) { 
+        return *data % 3 == 0; 
+    };
+
+    for (size_t run = 0; run < 2; run++) {
+        // relinking the nodes in data order scatters them across the node slabs
+        if (run == 1)
+            myList-> LIST_SORT;
+
+        auto begin = std::chrono::steady_clock::now();
+        size_t countA = 0;
+        myList-> LIST_PEEK_SET_HEAD;
+        while (myList-> LIST_PEEK_CURRENT != NULL) {
+            countA += predicate (& (myList-> LIST_PEEK_CURRENT-> data)) ? 1 : 0;
+            myList-> LIST_PEEK_SET_NEXT;
+        }
+        auto middle = std::chrono::steady_clock::now();
+        size_t countB = myList-> LIST_COUNT_IF (predicate);
+        auto end = std::chrono::steady_clock::now();
+
+        if (countA != countB)
+            return Quality::Test::FAIL;
+
+        std::cout << (run == 0 ? "slab order : " : "scattered : ")
+                  << "peek loop : " << std::chrono::duration_cast <std::chrono::milliseconds> (middle - begin).count()
+                  << " ms, count if : " << std::chrono::duration_cast <std::chrono::milliseconds> (end - middle).count()
+                  << " ms"
+                  << "\n";
+    }
+
+    LIST_CLOSE (55);
+    return Quality::Test::PASS;
+}
+#endif
+
 int main (void) {
     LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/List/");
     LIB_TEST_RUN_ALL;
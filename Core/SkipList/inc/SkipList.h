@@ -0,0 +1,71 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include "SkipListMgr.h"
+/* a skip list is a list that is always ordered by node id, so it has no methods to add a node at a given position (head,
+ * tail, before/after peek), or methods that would change the node order (swap, reverse, sort). Nodes are added using
+ * SKIPLIST_INSERT instead
+*/
+
+// skip list mgr methods
+#define SKIPLIST_INIT(id, dataType)             Memory::skipListMgr.initSkipList <dataType> (id)
+#define GET_SKIPLIST(id, dataType)              dynamic_cast <Memory::SkipList <dataType> *>                    \
+                                                (Memory::skipListMgr.getInstance (id))
+#define SKIPLIST_CLOSE(id)                      Memory::skipListMgr.closeInstance (id)
+#define SKIPLIST_CLOSE_ALL                      Memory::skipListMgr.closeAllInstances()
+#define SKIPLIST_MGR_DUMP                       Memory::skipListMgr.dump (std::cout)
+
+// 'set' operations
+#define SKIPLIST_PEEK_SET(id)                   peekSet (id)
+#define SKIPLIST_PEEK_SET_HEAD                  peekSetHead()
+#define SKIPLIST_PEEK_SET_TAIL                  peekSetTail()
+#define SKIPLIST_PEEK_SET_NEXT                  peekSetNext()
+#define SKIPLIST_PEEK_SET_PREVIOUS              peekSetPrevious()
+
+// 'execute' operations (these need to be executed after a 'set' operation)
+#define SKIPLIST_PEEK_CURRENT                   peekCurrent()
+#define SKIPLIST_PEEK_HEAD                      peekHead()
+#define SKIPLIST_PEEK_TAIL                      peekTail()
+
+#define SKIPLIST_INSERT(id, data)               insert (id, data)
+
+#define SKIPLIST_REMOVE                         remove()
+#define SKIPLIST_REMOVE_HEAD                    removeHead()
+#define SKIPLIST_REMOVE_TAIL                    removeTail()
+#define SKIPLIST_POP(id, data)                  pop (id, data)
+#define SKIPLIST_POP_HEAD(id, data)             popHead (id, data)
+#define SKIPLIST_POP_TAIL(id, data)             popTail (id, data)
+
+// search by data, returns an iterator (end() if not found)
+#define SKIPLIST_FIND(data)                     find (data)
+#define SKIPLIST_FIND_IF(lambda)                findIf (lambda)
+#define SKIPLIST_COUNT_IF(lambda)               countIf (lambda)
+#define SKIPLIST_REMOVE_IF(lambda)              removeIf (lambda)
+
+// utils
+#define SKIPLIST_LOWER_BOUND(id)                lowerBound (id)
+#define SKIPLIST_RANGE(idLow, idHigh)           getRange (idLow, idHigh)
+#define SKIPLIST_LEVELS                         getLevels()
+// operation counters, same as the list stats (an id lookup walks the towers and the nodes at level 0)
+#define SKIPLIST_STATS_ENABLE                   enableStats (true)
+#define SKIPLIST_STATS_DISABLE                  enableStats (false)
+#define SKIPLIST_STATS                          getStats()
+#define SKIPLIST_STATS_RESET                    resetStats()
+#define SKIPLIST_RESET                          reset()
+#define SKIPLIST_SIZE                           getSize()
+#define SKIPLIST_DUMP                           dump (std::cout)
+#define SKIPLIST_DUMP_CUSTOM(lambda)            dump (std::cout, lambda)
+#endif  // SKIPLIST_H
\ No newline at end of file
@@ -0,0 +1,349 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef SKIPLIST_IMPL_H
+#define SKIPLIST_IMPL_H
+
+#include "../../List/inc/ListImpl.h"
+
+// maximum number of levels above level 0, with a promotion probability of 1/4 this is enough for 4^32 nodes
+#define MAX_SKIP_LEVELS                 32
+
+namespace Collections {
+namespace Memory {
+    /* A skip list is a list ordered by node id, with additional 'express lanes' (levels) on top of it to speed up the
+     * search. Level 0 is the list itself (the doubly linked nodes of List), so all of the list's set and peek methods
+     * (peekSetNext(), peekSetPrevious() etc.) and iterators work as they are. A node is promoted to the next level with a
+     * probability of 1/4; only promoted nodes get a tower (forward pointers for levels 1 and above), so most nodes carry no
+     * extra memory at all
+     *
+     *  level 2     [head] ---------------------------------------> {7} ---------------------------> NULL
+     *  level 1     [head] ------------> {3} ---------------------> {7} ------------> {11} --------> NULL
+     *  level 0     [head] <-> {1} <-> {3} <-> {4} <-> {5} <-> {6} <-> {7} <-> {9} <-> {11} <-> {12} <-> NULL
+     *
+     * A search starts at the highest level, moves forward while the next node's id is less than the id we are looking for,
+     * and then drops down a level. At level 0 only a few nodes need to be walked, so search, insert and remove are all
+     * expected O(log n)
+     *
+     * The list is a protected base, so the list methods that would break the id order or leave the towers pointing at
+     * removed nodes (add/emplace/insert at a position, swap, reverse, sort, cursors, load etc.) can't be reached, not even
+     * through a List <T> pointer. The methods that are safe are made public again below
+    */
+    template <typename T>
+    class SkipList: public virtual Admin::NonTemplateBase, protected List <T> {
+        private:
+            typedef typename List <T>::s_Node m_Node;
+            typedef typename List <T>::iterator m_iterator;
+
+            // forward pointers of a promoted node, forward[0] is level 1
+            typedef struct Tower {
+                m_Node* node;
+                std::vector <Tower*> forward;
+            }s_Tower;
+
+            // start of each level
+            s_Tower* m_headForward[MAX_SKIP_LEVELS];
+            size_t m_numLevels;
+            uint64_t m_randomState;
+
+            // number of levels (above level 0) a new node is promoted to, each promotion has a probability of 1/4
+            size_t randomLevel (void) {
+                // xorshift64
+                m_randomState ^= m_randomState << 13;
+                m_randomState ^= m_randomState >> 7;
+                m_randomState ^= m_randomState << 17;
+
+                size_t level = 0;
+                uint64_t bits = m_randomState;
+                while (level < MAX_SKIP_LEVELS && (bits & 3) == 0) {
+                    level++;
+                    bits >>= 2;
+                }
+                return level;
+            }
+
+            // a NULL tower is the head of the level
+            inline s_Tower* getForward (s_Tower* tower, size_t level) {
+                return (tower == NULL) ? m_headForward[level - 1] : tower-> forward[level - 1];
+            }
+
+            inline void setForward (s_Tower* tower, size_t level, s_Tower* nextTower) {
+                if (tower == NULL)
+                    m_headForward[level - 1] = nextTower;
+                else
+                    tower-> forward[level - 1] = nextTower;
+            }
+
+            /* returns the first node with an id that is not less than the given id (NULL if there is no such node). The
+             * last tower visited in each level is saved in update (if not NULL), this is where a new tower for the id would
+             * be linked in. The number of towers and nodes visited is added to numNodesVisited (if not NULL)
+            */
+            m_Node* findLowerBound (size_t id, s_Tower** update, size_t* numNodesVisited = NULL) {
+                size_t numVisited = 0;
+                s_Tower* currentTower = NULL;
+                for (size_t level = m_numLevels; level >= 1; level--) {
+                    s_Tower* nextTower = getForward (currentTower, level);
+                    while (nextTower != NULL && nextTower-> node-> id < id) {
+                        currentTower = nextTower;
+                        nextTower = getForward (currentTower, level);
+                        numVisited++;
+                    }
+
+                    if (update != NULL)
+                        update[level - 1] = currentTower;
+                }
+
+                // finish the search at level 0, starting from the last tower visited
+                m_Node* currentNode = (currentTower == NULL) ? List <T>::m_headNode : currentTower-> node-> next;
+                while (currentNode != NULL && currentNode-> id < id) {
+                    currentNode = currentNode-> next;
+                    numVisited++;
+                }
+
+                if (numNodesVisited != NULL)
+                    *numNodesVisited += numVisited;
+                return currentNode;
+            }
+
+            // if id is not found (invalid), this method returns NULL. Counted as a lookup in the list stats
+            m_Node* getNode (size_t id) {
+                size_t numNodesVisited = 0;
+                m_Node* currentNode = findLowerBound (id, NULL, &numNodesVisited);
+
+                List <T>::countLookup (numNodesVisited);
+                return (currentNode != NULL && currentNode-> id == id) ? currentNode : NULL;
+            }
+
+            // remove the tower of the node (if it has one) from all levels
+            void unlinkTower (m_Node* node) {
+                s_Tower* update[MAX_SKIP_LEVELS];
+                findLowerBound (node-> id, update);
+
+                s_Tower* tower = NULL;
+                for (size_t level = 1; level <= m_numLevels; level++) {
+                    s_Tower* nextTower = getForward (update[level - 1], level);
+                    // towers always start at level 1, so we can stop at the first level the node is not in
+                    if (nextTower == NULL || nextTower-> node != node)
+                        break;
+
+                    tower = nextTower;
+                    setForward (update[level - 1], level, tower-> forward[level - 1]);
+                }
+                delete tower;
+
+                // drop levels that are now empty
+                while (m_numLevels > 0 && m_headForward[m_numLevels - 1] == NULL)
+                    m_numLevels--;
+            }
+
+            void resetTowers (void) {
+                // every tower is part of level 1
+                s_Tower* tower = (m_numLevels == 0) ? NULL : m_headForward[0];
+                while (tower != NULL) {
+                    s_Tower* nextTower = tower-> forward[0];
+                    delete tower;
+
+                    tower = nextTower;
+                }
+
+                for (auto& headTower : m_headForward)
+                    headTower = NULL;
+                m_numLevels = 0;
+            }
+
+        public:
+            typedef typename List <T>::iterator iterator;
+            typedef typename List <T>::const_iterator const_iterator;
+
+            // list methods that don't change the node order
+            using List <T>::peekSetHead;
+            using List <T>::peekSetTail;
+            using List <T>::peekSetNext;
+            using List <T>::peekSetPrevious;
+            using List <T>::peekCurrent;
+            using List <T>::peekHead;
+            using List <T>::peekTail;
+            using List <T>::find;
+            using List <T>::findIf;
+            using List <T>::countIf;
+            using List <T>::getSize;
+            using List <T>::publish;
+            using List <T>::snapshot;
+            using List <T>::save;
+            using List <T>::mapFile;
+            using List <T>::begin;
+            using List <T>::end;
+            using List <T>::cbegin;
+            using List <T>::cend;
+            using List <T>::dump;
+            // stats
+            using List <T>::enableStats;
+            using List <T>::isStatsEnabled;
+            using List <T>::getStats;
+            using List <T>::resetStats;
+            using List <T>::dumpStats;
+
+            SkipList (size_t instanceId) : List <T> (instanceId) {
+                for (auto& headTower : m_headForward)
+                    headTower = NULL;
+
+                m_numLevels = 0;
+                // xorshift state must be non zero
+                m_randomState = 0x9E3779B97F4A7C15ULL ^ instanceId;
+            }
+
+            ~SkipList (void) {
+                // nodes are destroyed by the list
+                resetTowers();
+            }
+
+            inline void peekSet (size_t id) {
+                List <T>::countPeekSet();
+                List <T>::m_peekNode = getNode (id);
+            }
+
+            /* insert a new node in id order, returns false if a node with the same id already exists (the list is not
+             * updated in that case)
+            */
+            bool insert (size_t id, const T& data) {
+                s_Tower* update[MAX_SKIP_LEVELS];
+                m_Node* nextNode = findLowerBound (id, update);
+
+                // id already exists
+                if (nextNode != NULL && nextNode-> id == id)
+                    return false;
+
+                m_Node* newNode = List <T>::createNode (id, data);
+                if (nextNode != NULL)
+                    List <T>::linkBefore (nextNode, newNode);
+
+                else if (List <T>::m_tailNode != NULL)
+                    List <T>::linkAfter (List <T>::m_tailNode, newNode);
+
+                // if new node is the only node in the list
+                else {
+                    List <T>::m_headNode = newNode;
+                    List <T>::m_tailNode = newNode;
+                }
+
+                size_t height = randomLevel();
+                if (height == 0)
+                    return true;
+
+                // new levels start at the head
+                for (size_t level = m_numLevels + 1; level <= height; level++)
+                    update[level - 1] = NULL;
+                m_numLevels = std::max (m_numLevels, height);
+
+                s_Tower* newTower = new s_Tower;
+                newTower-> node = newNode;
+                newTower-> forward.resize (height);
+
+                for (size_t level = 1; level <= height; level++) {
+                    newTower-> forward[level - 1] = getForward (update[level - 1], level);
+                    setForward (update[level - 1], level, newTower);
+                }
+                return true;
+            }
+
+            bool remove (void) {
+                m_Node* currentNode = List <T>::peekCurrent();
+                // id not found
+                if (currentNode == NULL)
+                    return false;
+
+                unlinkTower (currentNode);
+                return List <T>::remove();
+            }
+
+            bool removeHead (void) {
+                // set peek position to head
+                List <T>::peekSetHead();
+                return remove();
+            }
+
+            bool removeTail (void) {
+                // set peek position to tail
+                List <T>::peekSetTail();
+                return remove();
+            }
+
+            bool pop (size_t& id, T& data) {
+                m_Node* currentNode = List <T>::peekCurrent();
+                // id not found
+                if (currentNode == NULL)
+                    return false;
+
+                unlinkTower (currentNode);
+                return List <T>::pop (id, data);
+            }
+
+            bool popHead (size_t& id, T& data) {
+                // set peek position to head
+                List <T>::peekSetHead();
+                return pop (id, data);
+            }
+
+            bool popTail (size_t& id, T& data) {
+                // set peek position to tail
+                List <T>::peekSetTail();
+                return pop (id, data);
+            }
+
+            size_t removeIf (bool (*lambda) (T*)) {
+                size_t numRemoved = 0;
+                m_Node* currentNode = List <T>::m_headNode;
+                while (currentNode != NULL) {
+                    m_Node* nextNode = currentNode-> next;
+                    if (lambda (& (currentNode-> data))) {
+                        unlinkTower (currentNode);
+                        List <T>::unlinkNode (currentNode);
+                        List <T>::destroyNode (currentNode);
+                        numRemoved++;
+                    }
+                    currentNode = nextNode;
+                }
+                return numRemoved;
+            }
+
+            // iterator at the first node with an id that is not less than the given id
+            m_iterator lowerBound (size_t id) {
+                return m_iterator (findLowerBound (id, NULL), this);
+            }
+
+            // all nodes with ids in [idLow, idHigh], in id order
+            std::ranges::subrange <m_iterator> getRange (size_t idLow, size_t idHigh) {
+                if (idLow > idHigh)
+                    return { List <T>::end(), List <T>::end() };
+
+                m_Node* lowNode = findLowerBound (idLow, NULL);
+                m_Node* highNode = findLowerBound (idHigh, NULL);
+                // range end is one past the last node in range
+                if (highNode != NULL && highNode-> id == idHigh)
+                    highNode = highNode-> next;
+
+                return { m_iterator (lowNode, this), m_iterator (highNode, this) };
+            }
+
+            void reset (void) {
+                resetTowers();
+                List <T>::reset();
+            }
+
+            inline size_t getLevels (void) {
+                return m_numLevels;
+            }
+    };
+}   // namespace Memory
+}   // namespace Collections
+#endif  // SKIPLIST_IMPL_H
\ No newline at end of file
@@ -0,0 +1,273 @@
+/*
+ Copyright 2022, Author: VIJOY SUNIL KUMAR
+ 
+ All rights reserved. No part of this source code may be reproduced or distributed by any means without prior written permission of
+ the copyright owner. It is strictly prohibited to publish any parts of the source code to publicly accessible repositories or
+ websites. The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "../inc/SkipList.h"
+#include "../../../Common/LibTest/inc/LibTest.h"
+#include <set>
+#include <random>
+
+using namespace Collections;
+
+LIB_TEST_CASE (0, "multiple instances") {
+    auto myList0 = SKIPLIST_INIT (0, int);
+    SKIPLIST_INIT (1, std::string);
+
+    // or use GET_ to get list instance
+    auto myList1 = GET_SKIPLIST (1, std::string);
+
+    myList0-> SKIPLIST_INSERT (1, 26);
+    myList1-> SKIPLIST_INSERT (1, "John");
+
+    myList0-> SKIPLIST_DUMP;
+    myList1-> SKIPLIST_DUMP;
+
+    SKIPLIST_MGR_DUMP;
+    SKIPLIST_CLOSE_ALL;
+    SKIPLIST_MGR_DUMP;
+
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (1, "insert in id order") {
+    auto myList = SKIPLIST_INIT (1, int);
+
+    size_t input[] = { 5, 1, 9, 3, 7, 2, 8, 4, 6 };
+    for (auto id : input) {
+        if (myList-> SKIPLIST_INSERT (id, static_cast <int> (id * 10)) == false)
+            return Quality::Test::FAIL;
+    }
+    myList-> SKIPLIST_DUMP;
+
+    if (myList-> SKIPLIST_SIZE != 9)
+        return Quality::Test::FAIL;
+
+    // forward
+    size_t expectedId = 1;
+    myList-> SKIPLIST_PEEK_SET_HEAD;
+    while (myList-> SKIPLIST_PEEK_CURRENT != NULL) {
+        if (myList-> SKIPLIST_PEEK_CURRENT-> id != expectedId || 
+            myList-> SKIPLIST_PEEK_CURRENT-> data != static_cast <int> (expectedId * 10))
+            return Quality::Test::FAIL;
+
+        expectedId++;
+        myList-> SKIPLIST_PEEK_SET_NEXT;
+    }
+
+    // backward
+    expectedId = 9;
+    myList-> SKIPLIST_PEEK_SET_TAIL;
+    while (myList-> SKIPLIST_PEEK_CURRENT != NULL) {
+        if (myList-> SKIPLIST_PEEK_CURRENT-> id != expectedId)
+            return Quality::Test::FAIL;
+
+        expectedId--;
+        myList-> SKIPLIST_PEEK_SET_PREVIOUS;
+    }
+
+    if (myList-> SKIPLIST_PEEK_HEAD-> id != 1 || myList-> SKIPLIST_PEEK_TAIL-> id != 9)
+        return Quality::Test::FAIL;
+
+    SKIPLIST_CLOSE (1);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (2, "duplicate and invalid ids") {
+    auto myList = SKIPLIST_INIT (2, int);
+
+    myList-> SKIPLIST_INSERT (10, 100);
+    myList-> SKIPLIST_INSERT (20, 200);
+
+    // duplicate id is not inserted
+    if (myList-> SKIPLIST_INSERT (10, 101) == true || myList-> SKIPLIST_SIZE != 2)
+        return Quality::Test::FAIL;
+
+    myList-> SKIPLIST_PEEK_SET (10);
+    if (myList-> SKIPLIST_PEEK_CURRENT == NULL || myList-> SKIPLIST_PEEK_CURRENT-> data != 100)
+        return Quality::Test::FAIL;
+
+    // invalid id
+    myList-> SKIPLIST_PEEK_SET (15);
+    if (myList-> SKIPLIST_PEEK_CURRENT != NULL || myList-> SKIPLIST_REMOVE == true)
+        return Quality::Test::FAIL;
+
+    SKIPLIST_CLOSE (2);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (3, "remove") {
+    auto myList = SKIPLIST_INIT (3, int);
+
+    for (size_t id = 1; id <= 10; id++)
+        myList-> SKIPLIST_INSERT (id, static_cast <int> (id));
+
+    myList-> SKIPLIST_PEEK_SET (5);
+    myList-> SKIPLIST_REMOVE;
+    myList-> SKIPLIST_REMOVE_HEAD;
+    myList-> SKIPLIST_REMOVE_TAIL;
+    myList-> SKIPLIST_DUMP;
+
+    // { 2, 3, 4, 6, 7, 8, 9 }
+    size_t output[] = { 2, 3, 4, 6, 7, 8, 9 };
+    size_t i = 0;
+    for (auto& data : *myList) {
+        if (data != static_cast <int> (output[i++]))
+            return Quality::Test::FAIL;
+    }
+
+    if (i != 7 || myList-> SKIPLIST_SIZE != 7)
+        return Quality::Test::FAIL;
+
+    // removed id can be inserted again
+    if (myList-> SKIPLIST_INSERT (5, 5) == false)
+        return Quality::Test::FAIL;
+
+    // { 2, 3, 4, 5, 6, 7, 8, 9 }
+    size_t id;
+    int data;
+    if (myList-> SKIPLIST_POP_HEAD (id, data) == false || id != 2 || data != 2)
+        return Quality::Test::FAIL;
+
+    myList-> SKIPLIST_PEEK_SET (5);
+    if (myList-> SKIPLIST_POP (id, data) == false || id != 5 || myList-> SKIPLIST_SIZE != 6)
+        return Quality::Test::FAIL;
+
+    myList-> SKIPLIST_PEEK_SET (5);
+    if (myList-> SKIPLIST_PEEK_CURRENT != NULL)
+        return Quality::Test::FAIL;
+
+    myList-> SKIPLIST_RESET;
+    if (myList-> SKIPLIST_SIZE != 0 || myList-> SKIPLIST_LEVELS != 0 || myList-> SKIPLIST_REMOVE_HEAD == true)
+        return Quality::Test::FAIL;
+
+    SKIPLIST_CLOSE (3);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (4, "lower bound and range") {
+    auto myList = SKIPLIST_INIT (4, int);
+
+    // 10, 20, ... 100
+    for (size_t id = 10; id <= 100; id += 10)
+        myList-> SKIPLIST_INSERT (id, static_cast <int> (id));
+
+    auto it = myList-> SKIPLIST_LOWER_BOUND (35);
+    if (it == myList-> end() || it.getId() != 40)
+        return Quality::Test::FAIL;
+
+    if (myList-> SKIPLIST_LOWER_BOUND (101) != myList-> end())
+        return Quality::Test::FAIL;
+
+    // [25, 70] -> 30, 40, 50, 60, 70
+    int expected = 30;
+    for (auto& data : myList-> SKIPLIST_RANGE (25, 70)) {
+        if (data != expected)
+            return Quality::Test::FAIL;
+        expected += 10;
+    }
+    if (expected != 80)
+        return Quality::Test::FAIL;
+
+    // empty ranges
+    if (!myList-> SKIPLIST_RANGE (41, 49).empty() || !myList-> SKIPLIST_RANGE (70, 30).empty())
+        return Quality::Test::FAIL;
+
+    // whole list
+    if (std::ranges::distance (myList-> SKIPLIST_RANGE (0, 1000)) != 10)
+        return Quality::Test::FAIL;
+
+    SKIPLIST_CLOSE (4);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (5, "random insert/remove against std::set") {
+    auto myList = SKIPLIST_INIT (5, size_t);
+    std::set <size_t> groundTruth;
+
+    std::mt19937 generator (5);
+    std::uniform_int_distribution <size_t> distribution (0, 20000);
+
+    for (size_t i = 0; i < 100000; i++) {
+        size_t id = distribution (generator);
+
+        if (i % 3 == 0) {
+            myList-> SKIPLIST_PEEK_SET (id);
+            if (myList-> SKIPLIST_REMOVE != (groundTruth.erase (id) == 1))
+                return Quality::Test::FAIL;
+        }
+        else {
+            if (myList-> SKIPLIST_INSERT (id, id) != groundTruth.insert (id).second)
+                return Quality::Test::FAIL;
+        }
+    }
+
+    if (myList-> SKIPLIST_SIZE != groundTruth.size())
+        return Quality::Test::FAIL;
+
+    // remove odd ids, the remaining nodes are still reachable by id
+    size_t numRemoved = myList-> SKIPLIST_REMOVE_IF ([](size_t* data) { return *data % 2 == 1; });
+    if (numRemoved != std::erase_if (groundTruth, [](size_t id) { return id % 2 == 1; }))
+        return Quality::Test::FAIL;
+
+    for (auto id : groundTruth) {
+        myList-> SKIPLIST_PEEK_SET (id);
+        if (myList-> SKIPLIST_PEEK_CURRENT == NULL)
+            return Quality::Test::FAIL;
+    }
+
+    auto it = myList-> begin();
+    for (auto id : groundTruth) {
+        if (it.getId() != id || *it != id)
+            return Quality::Test::FAIL;
+        ++it;
+    }
+
+    std::cout << "size : "      << myList-> SKIPLIST_SIZE 
+              << ", levels : "  << myList-> SKIPLIST_LEVELS
+              << "\n";
+
+    SKIPLIST_CLOSE (5);
+    return Quality::Test::PASS;
+}
+
+LIB_TEST_CASE (6, "list interface and stats") {
+    auto myList = SKIPLIST_INIT (6, int);
+
+    // methods that would break the id order can't be reached through a list pointer either
+    static_assert (!std::is_convertible <Memory::SkipList <int>*, Memory::List <int>*>::value);
+    if (GET_SKIPLIST (6, int) != myList)
+        return Quality::Test::FAIL;
+
+    myList-> SKIPLIST_STATS_ENABLE;
+    for (size_t id = 0; id < 1000; id++)
+        myList-> SKIPLIST_INSERT (id, static_cast <int> (id));
+
+    myList-> SKIPLIST_PEEK_SET (999);
+    myList-> SKIPLIST_PEEK_SET (5000);
+    myList-> SKIPLIST_REMOVE_HEAD;
+
+    auto stats = myList-> SKIPLIST_STATS;
+    // towers keep the lookups well below a walk from the head
+    if (stats.numAdds != 1000 || stats.numRemoves != 1 || stats.numPeekSets != 2 || stats.numLookups != 2 ||
+        stats.numNodesVisited >= 1000)
+        return Quality::Test::FAIL;
+
+    SKIPLIST_CLOSE (6);
+    return Quality::Test::PASS;
+}
+
+int main (void) {
+    LIB_TEST_INIT (Quality::Test::TO_CONSOLE | Quality::Test::TO_FILE, "./Build/Save/SkipList/");
+    LIB_TEST_RUN_ALL;
+
+    return 0;
+}
\ No newline at end of file